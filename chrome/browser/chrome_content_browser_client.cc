@@ -3,7 +3,6 @@
 // found in the LICENSE file.
 
 #include "chrome/browser/chrome_content_browser_client.h"
-#include "base/base64.h"
 #include <algorithm>
 #include <iterator>
 #include <map>
@@ -2708,33 +2707,6 @@ void MaybeAppendBlinkSettingsSwitchForFieldTrial(
 void ChromeContentBrowserClient::AppendExtraCommandLineSwitches(
     base::CommandLine* command_line,
     int child_process_id) {
-  // >>>>>>>>> [޸] Զȡָòӽ
-  // ޸ 1: ʹָ (new std::string)  exit-time destructor 
-  static std::string* fingerprint_encoded_data = new std::string();
-  static bool fingerprint_loaded = false;
-
-  // ʹþ̬ȷֻȡһӲ
-  if (!fingerprint_loaded) {
-    base::FilePath exe_dir;
-    if (base::PathService::Get(base::DIR_EXE, &exe_dir)) {
-      base::FilePath config_path = exe_dir.AppendASCII("fingerprint.json");
-      std::string json_content;
-
-      // ļҶȡɹ
-      if (base::ReadFileToString(config_path, &json_content)) {
-        // ޸ 2: ° Base64Encode API (ֱӷַ)
-        *fingerprint_encoded_data = base::Base64Encode(json_content);
-      }
-    }
-    fingerprint_loaded = true;
-  }
-
-  // ɹȡݣΪע뵽ӽ
-  if (!fingerprint_encoded_data->empty()) {
-    command_line->AppendSwitchASCII("fingerprint-config-data",
-                                    *fingerprint_encoded_data);
-  }
-  // <<<<<<<<< 
   crash_keys::AppendStringAnnotationsCommandLineSwitch(command_line);
 #if BUILDFLAG(IS_MAC)
   std::unique_ptr<metrics::ClientInfo> client_info =
@@ -0,0 +1,547 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/fingerprint/fingerprint_config_service.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_path_watcher.h"
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/supports_user_data.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/task/updateable_sequenced_task_runner.h"
+#include "base/values.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "ipc/ipc_channel_proxy.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_config_image.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_gpu_profile_library.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_identity.h"
+#include "third_party/blink/public/mojom/fingerprint/fingerprint_config.mojom.h"
+
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
+#include "base/files/scoped_file.h"
+#include "base/memory/platform_shared_memory_region.h"
+#include "content/browser/child_process_launcher.h"
+#else
+#include "base/base64.h"
+#endif
+
+#if BUILDFLAG(IS_WIN)
+#include <time.h>
+#endif
+
+namespace content {
+
+namespace {
+
+const char kFingerprintIdentityUserDataKey[] = "fingerprint_identity";
+
+// Remembers which identity file a RenderProcessHost was launched with and
+// which snapshot of it (Identity::generation) the process last received. The
+// path is unset while the profile's identity file is still being resolved.
+class IdentityUserData : public base::SupportsUserData::Data {
+ public:
+  explicit IdentityUserData(std::optional<base::FilePath> identity_path)
+      : identity_path_(std::move(identity_path)) {}
+
+  const std::optional<base::FilePath>& identity_path() const {
+    return identity_path_;
+  }
+  void set_identity_path(const base::FilePath& identity_path) {
+    identity_path_ = identity_path;
+  }
+
+  uint64_t generation() const { return generation_; }
+  void set_generation(uint64_t generation) { generation_ = generation; }
+
+ private:
+  std::optional<base::FilePath> identity_path_;
+  uint64_t generation_ = 0;
+};
+
+IdentityUserData* GetIdentityUserData(RenderProcessHost* host) {
+  return static_cast<IdentityUserData*>(
+      host->GetUserData(kFingerprintIdentityUserDataKey));
+}
+
+// The GPU profile library, mapped on first use and kept for the lifetime of
+// the browser; nullptr if there is none. Only the profile an identity selects
+// is copied into its image, so renderers never map the library. Blocks on the
+// first call, which happens on the file task runner.
+const blink::FingerprintGpuProfileLibrary* GetGpuProfileLibrary() {
+  static const blink::FingerprintGpuProfileLibrary* const library =
+      []() -> const blink::FingerprintGpuProfileLibrary* {
+    const base::FilePath path = blink::GetFingerprintGpuProfileLibraryPath();
+    if (path.empty() || !base::PathExists(path)) {
+      return nullptr;
+    }
+    static base::NoDestructor<base::MemoryMappedFile> file;
+    if (!file->Initialize(path)) {
+      LOG(ERROR) << ">>> [FINGERPRINT] ERROR: Could not map "
+                 << path.AsUTF8Unsafe();
+      return nullptr;
+    }
+    const blink::FingerprintGpuProfileLibrary* result =
+        blink::FingerprintGpuProfileLibrary::FromBytesVerified(file->bytes());
+    if (!result) {
+      LOG(ERROR) << ">>> [FINGERPRINT] ERROR: " << path.AsUTF8Unsafe()
+                 << " is not a valid GPU profile library";
+    }
+    return result;
+  }();
+  return library;
+}
+
+// Reads |path| and compiles it into a blink::FingerprintConfigImage. Images
+// compiled offline (.fpci) are only checksummed. Blocks.
+std::optional<std::vector<uint8_t>> ReadAndCompileConfig(
+    const base::FilePath& path) {
+  std::string config_content;
+  if (!base::ReadFileToString(path, &config_content)) {
+    LOG(ERROR) << ">>> [FINGERPRINT] ERROR: Could not read "
+               << path.AsUTF8Unsafe();
+    return std::nullopt;
+  }
+
+  if (path.MatchesExtension(blink::kFingerprintImageExtension)) {
+    std::vector<uint8_t> image_bytes(config_content.begin(),
+                                     config_content.end());
+    if (!blink::FingerprintConfigImage::FromBytesVerified(image_bytes)) {
+      LOG(ERROR) << ">>> [FINGERPRINT] ERROR: " << path.AsUTF8Unsafe()
+                 << " is not a valid image (stale compiler or corrupt file)";
+      return std::nullopt;
+    }
+    return image_bytes;
+  }
+
+  std::optional<base::Value::Dict> root =
+      base::JSONReader::ReadDict(config_content);
+  if (!root) {
+    // Also hit while an editor is half-way through rewriting the file; the
+    // previous snapshot stays in use until a valid one is written.
+    LOG(ERROR) << ">>> [FINGERPRINT] ERROR: " << path.AsUTF8Unsafe()
+               << " is not a dict";
+    return std::nullopt;
+  }
+  // Hand-edited JSON stays lenient at runtime; fingerprint_config_compiler
+  // turns these warnings into hard errors.
+  std::vector<std::string> errors;
+  if (!blink::FingerprintConfigImage::Validate(*root, &errors)) {
+    for (const std::string& error : errors) {
+      LOG(WARNING) << ">>> [FINGERPRINT] " << path.AsUTF8Unsafe() << ": "
+                   << error;
+    }
+  }
+  const blink::FingerprintGpuProfileLibrary* gpu_profiles =
+      GetGpuProfileLibrary();
+  if (const std::string* profile =
+          root->FindStringByDottedPath("webgl.profile");
+      profile && (!gpu_profiles || !gpu_profiles->Find(*profile))) {
+    LOG(WARNING) << ">>> [FINGERPRINT] " << path.AsUTF8Unsafe()
+                 << ": unknown GPU profile " << *profile;
+  }
+  return blink::FingerprintConfigImage::Compile(*root, gpu_profiles);
+}
+
+// Sends |region| to |host| over its channel. Channel-associated, so this is
+// ordered before any CommitNavigation sent to |host| afterwards. Closing the
+// remote right away is fine; the message is already queued.
+void SendIdentity(RenderProcessHost* host,
+                  const base::ReadOnlySharedMemoryRegion& region) {
+  mojo::AssociatedRemote<blink::mojom::FingerprintConfigAgent> agent;
+  host->GetChannel()->GetRemoteAssociatedInterface(&agent);
+  agent->SetIdentity(region.Duplicate());
+}
+
+void RecompileConfig(
+    const base::FilePath& path,
+    base::RepeatingCallback<void(std::vector<uint8_t>)> on_image) {
+  if (std::optional<std::vector<uint8_t>> image_bytes =
+          ReadAndCompileConfig(path)) {
+    on_image.Run(std::move(*image_bytes));
+  }
+}
+
+}  // namespace
+
+// Lives on a MayBlock sequence and runs |on_changed| there whenever the
+// watched path changes on disk.
+class FingerprintConfigService::FileWatcher {
+ public:
+  FileWatcher(const base::FilePath& path, base::RepeatingClosure on_changed)
+      : on_changed_(std::move(on_changed)) {
+    if (!watcher_.Watch(path, base::FilePathWatcher::Type::kNonRecursive,
+                        base::BindRepeating(&FileWatcher::OnPathChanged,
+                                            base::Unretained(this)))) {
+      LOG(ERROR) << ">>> [FINGERPRINT] ERROR: Could not watch "
+                 << path.AsUTF8Unsafe();
+    }
+  }
+
+ private:
+  void OnPathChanged(const base::FilePath& path, bool error) {
+    if (!error) {
+      on_changed_.Run();
+    }
+  }
+
+  base::RepeatingClosure on_changed_;
+  base::FilePathWatcher watcher_;
+};
+
+FingerprintConfigService::Identity::Identity() = default;
+FingerprintConfigService::Identity::~Identity() = default;
+
+// static
+FingerprintConfigService& FingerprintConfigService::Get() {
+  static base::NoDestructor<FingerprintConfigService> instance;
+  return *instance;
+}
+
+FingerprintConfigService::FingerprintConfigService()
+    : file_task_runner_(base::ThreadPool::CreateUpdateableSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN})) {}
+
+FingerprintConfigService::~FingerprintConfigService() = default;
+
+void FingerprintConfigService::PreloadIdentity(
+    BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!identity_dir_watcher_) {
+    base::FilePath identity_dir = blink::GetFingerprintIdentityDir();
+    if (!identity_dir.empty()) {
+      identity_dir_watcher_ = base::SequenceBound<FileWatcher>(
+          file_task_runner_, identity_dir,
+          base::BindPostTask(
+              GetUIThreadTaskRunner({}),
+              base::BindRepeating(
+                  &FingerprintConfigService::ResetIdentityPaths,
+                  base::Unretained(this))));
+    }
+  }
+  if (!identity_path_for_profile_.contains(browser_context->GetPath())) {
+    ResolveIdentityPath(browser_context->GetPath());
+  }
+}
+
+void FingerprintConfigService::AppendRendererSwitches(
+    RenderProcessHost* host,
+    base::CommandLine* command_line,
+    bool is_spare) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (is_spare) {
+    // The spare may be handed to any profile; BindIdentity() sends it one.
+    host->RemoveUserData(kFingerprintIdentityUserDataKey);
+    command_line->AppendSwitch(blink::kFingerprintIdentityPendingSwitch);
+    return;
+  }
+  std::optional<base::FilePath> identity_path =
+      GetIdentityPath(host->GetBrowserContext());
+  auto data = std::make_unique<IdentityUserData>(identity_path);
+  // If the identity is not loaded yet the process starts without one and
+  // UpdateHost() sends it once SetImage() runs. AddRendererFileData() runs in
+  // the same launch and sees the same state.
+  bool pending = !identity_path;
+  if (identity_path && !identity_path->empty()) {
+    const Identity& identity = GetOrLoadIdentity(*identity_path);
+    pending = !identity.region.IsValid();
+#if !BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_MAC)
+    if (!pending) {
+      command_line->AppendSwitchASCII(blink::kFingerprintConfigImageSwitch,
+                                      identity.encoded_image);
+      data->set_generation(identity.generation);
+    }
+#endif
+  }
+  if (pending) {
+    command_line->AppendSwitch(blink::kFingerprintIdentityPendingSwitch);
+  }
+  host->SetUserData(kFingerprintIdentityUserDataKey, std::move(data));
+}
+
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
+void FingerprintConfigService::AddRendererFileData(
+    RenderProcessHost* host,
+    ChildProcessLauncherFileData* file_data) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  IdentityUserData* data = GetIdentityUserData(host);
+  if (!data || !data->identity_path() || data->identity_path()->empty()) {
+    return;
+  }
+  const Identity& identity = GetOrLoadIdentity(*data->identity_path());
+  if (!identity.region.IsValid()) {
+    return;
+  }
+  data->set_generation(identity.generation);
+  base::subtle::PlatformSharedMemoryRegion platform_region =
+      base::ReadOnlySharedMemoryRegion::TakeHandleForSerialization(
+          identity.region.Duplicate());
+#if BUILDFLAG(IS_ANDROID)
+  base::ScopedFD fd = platform_region.PassPlatformHandle();
+#else
+  base::ScopedFD fd = std::move(platform_region.PassPlatformHandle().fd);
+#endif
+  file_data->files_to_preload.emplace(
+      blink::kFingerprintConfigImageDescriptorKey, std::move(fd));
+}
+#endif
+
+void FingerprintConfigService::BindIdentity(RenderProcessHost* host) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (GetIdentityUserData(host) || !host->GetChannel()) {
+    return;
+  }
+  host->SetUserData(kFingerprintIdentityUserDataKey,
+                    std::make_unique<IdentityUserData>(
+                        GetIdentityPath(host->GetBrowserContext())));
+  // Spares are only taken once IsIdentityReady(), so this is queued ahead of
+  // the CommitNavigation that made the browser pick |host|.
+  UpdateHost(host);
+}
+
+bool FingerprintConfigService::IsIdentityReady(
+    BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  const std::optional<base::FilePath> identity_path =
+      GetIdentityPath(browser_context);
+  if (!identity_path) {
+    return false;
+  }
+  return identity_path->empty() || !GetOrLoadIdentity(*identity_path).loading;
+}
+
+bool FingerprintConfigService::IsCompatibleHost(
+    RenderProcessHost* host,
+    BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!IsIdentityReady(browser_context)) {
+    // Whatever |host| runs now, a navigation committed into it would not see
+    // this profile's identity.
+    return false;
+  }
+  const IdentityUserData* data = GetIdentityUserData(host);
+  if (!data) {
+    // A spare; BindIdentity() sends it the loaded identity.
+    return true;
+  }
+  const base::FilePath identity_path = *GetIdentityPath(browser_context);
+  if (data->identity_path() != identity_path) {
+    return false;
+  }
+  // A host launched before the identity was loaded that has not received it
+  // yet, or one that missed a reload (no channel while SetImage() ran), must
+  // not take new navigations.
+  auto it = identities_.find(identity_path);
+  return it == identities_.end() ||
+         data->generation() == it->second->generation;
+}
+
+std::optional<base::FilePath> FingerprintConfigService::GetIdentityPath(
+    BrowserContext* browser_context) {
+  auto it = identity_path_for_profile_.find(browser_context->GetPath());
+  if (it != identity_path_for_profile_.end()) {
+    return it->second;
+  }
+  PreloadIdentity(browser_context);
+  return std::nullopt;
+}
+
+void FingerprintConfigService::ResolveIdentityPath(
+    const base::FilePath& profile_path) {
+  if (!resolving_profiles_.insert(profile_path).second) {
+    return;
+  }
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&blink::GetFingerprintIdentityPath, profile_path),
+      base::BindOnce(&FingerprintConfigService::OnIdentityPathResolved,
+                     base::Unretained(this), profile_path));
+  UpdateFileTaskPriority();
+}
+
+void FingerprintConfigService::OnIdentityPathResolved(
+    const base::FilePath& profile_path,
+    base::FilePath identity_path) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  resolving_profiles_.erase(profile_path);
+  identity_path_for_profile_[profile_path] = identity_path;
+  if (!identity_path.empty()) {
+    GetOrLoadIdentity(identity_path);
+  }
+  for (RenderProcessHost::iterator it = RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    RenderProcessHost* host = it.GetCurrentValue();
+    IdentityUserData* data = GetIdentityUserData(host);
+    if (data && !data->identity_path() &&
+        host->GetBrowserContext()->GetPath() == profile_path) {
+      data->set_identity_path(identity_path);
+      UpdateHost(host);
+    }
+  }
+  UpdateFileTaskPriority();
+}
+
+FingerprintConfigService::Identity&
+FingerprintConfigService::GetOrLoadIdentity(
+    const base::FilePath& identity_path) {
+  std::unique_ptr<Identity>& slot = identities_[identity_path];
+  if (slot) {
+    return *slot;
+  }
+  slot = std::make_unique<Identity>();
+
+  auto on_image = base::BindPostTask(
+      GetUIThreadTaskRunner({}),
+      base::BindRepeating(&FingerprintConfigService::SetImage,
+                          base::Unretained(this), identity_path));
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&ReadAndCompileConfig, identity_path),
+      base::BindOnce(&FingerprintConfigService::OnIdentityLoaded,
+                     base::Unretained(this), identity_path));
+  slot->file_watcher = base::SequenceBound<FileWatcher>(
+      file_task_runner_, identity_path,
+      base::BindRepeating(&RecompileConfig, identity_path, on_image));
+  UpdateFileTaskPriority();
+  return *slot;
+}
+
+void FingerprintConfigService::OnIdentityLoaded(
+    const base::FilePath& identity_path,
+    std::optional<std::vector<uint8_t>> image_bytes) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  identities_.at(identity_path)->loading = false;
+  if (image_bytes) {
+    SetImage(identity_path, std::move(*image_bytes));
+  }
+  UpdateFileTaskPriority();
+}
+
+void FingerprintConfigService::UpdateFileTaskPriority() {
+  bool first_load_pending = false;
+  for (const base::FilePath& profile_path : resolving_profiles_) {
+    if (!identity_path_for_profile_.contains(profile_path)) {
+      first_load_pending = true;
+    }
+  }
+  for (const auto& entry : identities_) {
+    if (entry.second->loading) {
+      first_load_pending = true;
+    }
+  }
+  // Navigations of a profile whose identity is still loading get no existing
+  // process (see IsCompatibleHost()), so that load is on the critical path.
+  file_task_runner_->UpdatePriority(first_load_pending
+                                        ? base::TaskPriority::USER_BLOCKING
+                                        : base::TaskPriority::BEST_EFFORT);
+}
+
+void FingerprintConfigService::UpdateHost(RenderProcessHost* host) {
+  IdentityUserData* data = GetIdentityUserData(host);
+  if (!data || !data->identity_path() || data->identity_path()->empty() ||
+      !host->GetChannel()) {
+    return;
+  }
+  auto it = identities_.find(*data->identity_path());
+  if (it == identities_.end() || !it->second->region.IsValid() ||
+      data->generation() == it->second->generation) {
+    return;
+  }
+  SendIdentity(host, it->second->region);
+  data->set_generation(it->second->generation);
+}
+
+void FingerprintConfigService::SetImage(const base::FilePath& identity_path,
+                                         std::vector<uint8_t> image_bytes) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  Identity& identity = *identities_.at(identity_path);
+  const blink::FingerprintConfigImage* image =
+      blink::FingerprintConfigImage::FromBytes(image_bytes);
+  CHECK(image);
+
+  // The watcher fires for every write to the file, often several per save,
+  // and for saves that change nothing. Identical images keep the current
+  // snapshot, so renderers are not sent (and do not retain) a copy.
+  if (identity.region.IsValid()) {
+    base::ReadOnlySharedMemoryMapping current = identity.region.Map();
+    if (current.IsValid() &&
+        std::ranges::equal(current.GetMemoryAsSpan<uint8_t>(), image_bytes)) {
+      return;
+    }
+  }
+
+  base::MappedReadOnlyRegion mapped =
+      base::ReadOnlySharedMemoryRegion::Create(image_bytes.size());
+  if (!mapped.IsValid()) {
+    LOG(ERROR) << ">>> [FINGERPRINT] ERROR: Could not allocate config region";
+    return;
+  }
+  mapped.mapping.GetMemoryAsSpan<uint8_t>().copy_from(image_bytes);
+  identity.region = std::move(mapped.region);
+  ++identity.generation;
+
+#if !BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_MAC)
+  identity.encoded_image = base::Base64Encode(image_bytes);
+#endif
+
+  // Renderers already running this identity switch to the new snapshot too;
+  // otherwise a profile would keep serving the old identity from every
+  // process it reuses while new processes get the new one.
+  // This also delivers the first snapshot to hosts launched while it was
+  // still loading.
+  for (RenderProcessHost::iterator it = RenderProcessHost::AllHostsIterator();
+       !it.IsAtEnd(); it.Advance()) {
+    RenderProcessHost* host = it.GetCurrentValue();
+    IdentityUserData* data = GetIdentityUserData(host);
+    if (data && data->identity_path() == identity_path) {
+      UpdateHost(host);
+    }
+  }
+
+  std::string timezone_id;
+  if (image->HasFlag(blink::FingerprintConfigImage::kTimezoneSpoofing)) {
+    timezone_id = std::string(image->GetString(image->timezone_zone_id));
+  }
+  if (timezone_id != identity.timezone_id) {
+    identity.timezone_id = std::move(timezone_id);
+#if BUILDFLAG(IS_WIN)
+    // 设置 Browser 进程环境 (仅浏览器级 fingerprint.json)
+    if (identity_path.BaseName() ==
+        base::FilePath(blink::kFingerprintConfigFileName)) {
+      _putenv_s("TZ", identity.timezone_id.c_str());
+      _tzset();
+    }
+#endif
+    LOG(ERROR) << ">>> [FINGERPRINT] Browser: Dynamic Timezone Set to "
+               << identity.timezone_id << " for "
+               << identity_path.AsUTF8Unsafe();
+  }
+}
+
+void FingerprintConfigService::ResetIdentityPaths() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Launches keep using the previous resolution until the new one arrives.
+  for (const auto& entry : identity_path_for_profile_) {
+    ResolveIdentityPath(entry.first);
+  }
+}
+
+}  // namespace content
@@ -0,0 +1,191 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_FINGERPRINT_FINGERPRINT_CONFIG_SERVICE_H_
+#define CONTENT_BROWSER_FINGERPRINT_FINGERPRINT_CONFIG_SERVICE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/no_destructor.h"
+#include "base/threading/sequence_bound.h"
+#include "build/build_config.h"
+#include "content/common/content_export.h"
+
+namespace base {
+class CommandLine;
+class UpdateableSequencedTaskRunner;
+}  // namespace base
+
+namespace content {
+
+class BrowserContext;
+class RenderProcessHost;
+struct ChildProcessLauncherFileData;
+
+// The single browser-side owner of the fingerprint identities. Each identity
+// file is read and parsed once, compiled into a blink::FingerprintConfigImage
+// and kept in a read-only shared-memory region that every renderer of that
+// identity maps instead of re-parsing JSON.
+//
+// Only renderers consume the identity (UA, timezone, WebGL strings and the
+// noise parameters are all applied in Blink), so nothing is passed to GPU,
+// utility or network processes.
+//
+// A profile uses fingerprints/<profile dir name>.json next to the executable
+// when that file exists and falls back to the browser-wide fingerprint.json,
+// so one browser can host many identities, one per profile.
+//
+// Identities may select a captured GPU profile by name ("webgl.profile") from
+// gpu_profiles.fpgl next to the executable. The library is mapped once per
+// browser and looked up in O(1) when an identity is compiled; the selected
+// profile becomes part of the identity's image. Changes to the library take
+// effect after a restart.
+//
+// Spare renderers are launched before their profile is known, so they start
+// without an identity and receive it over blink::mojom::FingerprintConfigAgent
+// when they are assigned (see BindIdentity()).
+//
+// Identity files are resolved and compiled on a MayBlock sequence, never on
+// the UI thread. PreloadIdentity() starts that when the first host of a
+// profile is created; the sequence runs at USER_BLOCKING priority while a
+// profile's first load is outstanding and at BEST_EFFORT otherwise. Until that
+// load finishes no existing host (spare or not) is handed a navigation of the
+// profile, see IsIdentityReady(). A process created in that window starts
+// without an identity and is sent one over FingerprintConfigAgent as soon as
+// it is compiled; navigations committed into it before then run under the
+// renderer's placeholder config, not under any identity.
+//
+// Identity files are watched with base::FilePathWatcher; when one changes, the
+// new image is compiled off the UI thread and swapped in as a whole, so every
+// launch sees either the old or the new snapshot, never a mix. The new
+// snapshot is also pushed over FingerprintConfigAgent to the renderers already
+// running that identity.
+class CONTENT_EXPORT FingerprintConfigService {
+ public:
+  static FingerprintConfigService& Get();
+
+  FingerprintConfigService(const FingerprintConfigService&) = delete;
+  FingerprintConfigService& operator=(const FingerprintConfigService&) =
+      delete;
+
+  // Starts resolving and compiling the identity of |browser_context| on the
+  // file task runner unless that already happened. Does not block.
+  void PreloadIdentity(BrowserContext* browser_context);
+
+  // Records which identity |host| is being launched with. On platforms without
+  // descriptor sharing this also appends the Base64-encoded image; the
+  // renderer derives everything else, including the timezone, from the image.
+  // Spare renderers (|is_spare|) are launched without an identity, as are
+  // hosts launched while it is still loading; both get
+  // blink::kFingerprintIdentityPendingSwitch so that they wait for it instead
+  // of loading a fallback.
+  void AppendRendererSwitches(RenderProcessHost* host,
+                              base::CommandLine* command_line,
+                              bool is_spare);
+
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
+  // Hands a duplicate of the read-only region of |host|'s identity to the
+  // child being launched.
+  void AddRendererFileData(RenderProcessHost* host,
+                           ChildProcessLauncherFileData* file_data);
+#endif
+
+  // Sends |host| the identity of its browser context if it was launched
+  // without one (a spare renderer that is being assigned). Spares are only
+  // assigned once IsIdentityReady(), so the identity is queued on the channel
+  // ahead of the navigation that picked |host|. For a host created while the
+  // identity was loading it is sent once loaded. Does nothing for hosts that
+  // already have an identity or have no channel yet.
+  void BindIdentity(RenderProcessHost* host);
+
+  // Returns true once the identity file of |browser_context| is resolved and,
+  // if there is one, its first compile has finished (successfully or not).
+  bool IsIdentityReady(BrowserContext* browser_context);
+
+  // Returns false if |browser_context|'s identity is not ready yet, or |host|
+  // was launched with a different identity than the one |browser_context| uses
+  // now, or has not received its current snapshot, so process reuse never
+  // mixes identities or commits into a process that lacks one. Unbound hosts
+  // (spares) are compatible once the identity is ready; BindIdentity() sends
+  // it to them.
+  bool IsCompatibleHost(RenderProcessHost* host,
+                        BrowserContext* browser_context);
+
+ private:
+  friend class base::NoDestructor<FingerprintConfigService>;
+
+  class FileWatcher;
+
+  // The compiled snapshot of one identity file.
+  struct Identity {
+    Identity();
+    ~Identity();
+
+    base::ReadOnlySharedMemoryRegion region;
+    // Bumped by every SetImage(); hosts record the one they received.
+    uint64_t generation = 0;
+    // Set until the first compile replies, even if it fails.
+    bool loading = true;
+    std::string timezone_id;
+#if !BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_MAC)
+    std::string encoded_image;
+#endif
+    base::SequenceBound<FileWatcher> file_watcher;
+  };
+
+  FingerprintConfigService();
+  ~FingerprintConfigService();
+
+  // Returns the identity file used by renderers of |browser_context|, or
+  // nullopt (and starts resolving it) if it is not known yet. The result is
+  // cached per profile path and refreshed when identity files are added or
+  // removed.
+  std::optional<base::FilePath> GetIdentityPath(
+      BrowserContext* browser_context);
+  // Looks up the identity file of |profile_path| on |file_task_runner_|.
+  void ResolveIdentityPath(const base::FilePath& profile_path);
+  void OnIdentityPathResolved(const base::FilePath& profile_path,
+                              base::FilePath identity_path);
+  // Starts compiling |identity_path| on |file_task_runner_| on first use and
+  // watches it. The region stays invalid until SetImage() runs.
+  Identity& GetOrLoadIdentity(const base::FilePath& identity_path);
+  // Replies to the first compile of |identity_path|; |image_bytes| is nullopt
+  // if it failed.
+  void OnIdentityLoaded(const base::FilePath& identity_path,
+                        std::optional<std::vector<uint8_t>> image_bytes);
+  // Runs |file_task_runner_| at USER_BLOCKING while a first load is
+  // outstanding, and at BEST_EFFORT otherwise.
+  void UpdateFileTaskPriority();
+  // Sends |host| the current snapshot of its identity unless it already has
+  // it, it has no channel or the identity is not loaded yet.
+  void UpdateHost(RenderProcessHost* host);
+  // Replaces the snapshot of |identity_path| and sends it to the live
+  // renderers of that identity, unless |image_bytes| equals the current
+  // snapshot. Runs on the UI thread.
+  void SetImage(const base::FilePath& identity_path,
+                std::vector<uint8_t> image_bytes);
+  // Resolves the identity files of all known profiles again, e.g. after
+  // identity files were added or removed.
+  void ResetIdentityPaths();
+
+  scoped_refptr<base::UpdateableSequencedTaskRunner> file_task_runner_;
+  std::map<base::FilePath, std::unique_ptr<Identity>> identities_;
+  std::map<base::FilePath, base::FilePath> identity_path_for_profile_;
+  std::set<base::FilePath> resolving_profiles_;
+  base::SequenceBound<FileWatcher> identity_dir_watcher_;
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_FINGERPRINT_FINGERPRINT_CONFIG_SERVICE_H_
@@ -15,9 +15,6 @@
 #include <set>
 #include <utility>
 #include <vector>
-#include "base/base64.h"
-#include "base/path_service.h"
-#include "base/json/json_reader.h"
 #include "base/base_switches.h"
 #include "base/clang_profiling_buildflags.h"
 #include "base/command_line.h"
@@ -102,6 +99,7 @@
 #include "content/browser/field_trial_synchronizer.h"
 #include "content/browser/file_system/file_system_manager_impl.h"
 #include "content/browser/file_system_access/file_system_access_manager_impl.h"
+#include "content/browser/fingerprint/fingerprint_config_service.h"
 #include "content/browser/gpu/browser_gpu_client_delegate.h"
 #include "content/browser/gpu/compositor_util.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"
@@ -1634,6 +1632,9 @@ RenderProcessHostImpl::RenderProcessHostImpl(
                                             this,
                                             GetChildProcessTracingTrack(id_))) {
   CHECK(!browser_context->ShutdownStarted());
+  // [FINGERPRINT] Compile this profile's identity off the UI thread before the
+  // process is launched.
+  FingerprintConfigService::Get().PreloadIdentity(browser_context);
   TRACE_EVENT("shutdown", "RenderProcessHostImpl",
               ChromeTrackEvent::kRenderProcessHost, *this);
   TRACE_EVENT_BEGIN("shutdown", "Browser.RenderProcessHostImpl", tracing_track_,
@@ -1954,6 +1955,7 @@ bool RenderProcessHostImpl::Init() {
     auto file_data = std::make_unique<ChildProcessLauncherFileData>();
 #if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
     file_data->files_to_preload = GetV8SnapshotFilesToPreload(*cmd_line);
+    FingerprintConfigService::Get().AddRendererFileData(this, file_data.get());
 #endif
 
     // Spawn the child process asynchronously to avoid blocking the UI thread.
@@ -3552,48 +3554,12 @@ static void AppendCompositorCommandLineFlags(base::CommandLine* command_line) {
 void RenderProcessHostImpl::AppendRendererCommandLine(
     base::CommandLine* command_line) {
   // ================= [FINGERPRINT MOD START] =================
-  // 仅保留这一份逻辑，确保不要重复定义 exe_path
-  base::FilePath exe_path;
-  if (base::PathService::Get(base::DIR_EXE, &exe_path)) {
-    base::FilePath config_path = exe_path.AppendASCII("fingerprint.json");
-    std::string config_content;
-
-    if (base::ReadFileToString(config_path, &config_content)) {
-      // 1. 传递完整配置 (用于 Canvas/WebGL 等)
-      std::string encoded_config = base::Base64Encode(config_content);
-      command_line->AppendSwitchASCII("fingerprint-config", encoded_config);
-
-      // 2. 解析时区并注入
-      auto result =
-          base::JSONReader::ReadAndReturnValueWithError(config_content, 0);
-      if (result.has_value() && result->is_dict()) {
-        const auto& root = result->GetDict();
-        const auto* tz_config = root.FindDict("timezone");
-
-        if (tz_config) {
-          const std::string* zone_id = tz_config->FindString("zone_id");
-          bool spoof_enabled =
-              tz_config->FindBool("spoofing_enabled").value_or(false);
-
-          if (spoof_enabled && zone_id && !zone_id->empty()) {
-            // 动态注入开关
-            command_line->AppendSwitchASCII("force-timezone", *zone_id);
-
-            // 设置 Browser 进程环境
-#if BUILDFLAG(IS_WIN)
-            _putenv_s("TZ", zone_id->c_str());
-            _tzset();
-#endif
-            LOG(ERROR) << ">>> [FINGERPRINT] Browser: Dynamic Timezone Set to "
-                       << *zone_id;
-          }
-        }
-      }
-    } else {
-      // 读不到文件时打印日志
-      LOG(ERROR) << ">>> [FINGERPRINT] ERROR: Could not read fingerprint.json";
-    }
-  }
+  // fingerprint.json 只在浏览器进程解析一次；渲染进程通过只读共享内存映射
+  // 编译后的二进制镜像 (时区也从镜像读取)，这里只记录该进程使用的身份。
+  FingerprintConfigService::Get().AppendRendererSwitches(
+      this, command_line,
+      /*is_spare=*/spare_renderer_priority_status_ ==
+          SpareRendererPriorityStatus::kSpare);
   // ================= [FINGERPRINT MOD END] =================
  
   // Pass the process type first, so it shows first in process listings.
@@ -4726,6 +4692,12 @@ bool RenderProcessHostImpl::IsSuitableHost(
   if (host->GetBrowserContext() != browser_context)
     return false;
 
+  // [FINGERPRINT] 同一个渲染进程只能服务一个指纹身份 (profile)。
+  if (!FingerprintConfigService::Get().IsCompatibleHost(host,
+                                                         browser_context)) {
+    return false;
+  }
+
   // Do not allow sharing of guest and non-guest hosts.  Note that we also
   // enforce that `host` and `site_info` must belong to the same
   // StoragePartition via the InSameStoragePartition() check below.
@@ -5174,7 +5146,10 @@ RenderProcessHost* RenderProcessHostImpl::GetProcessHostForSiteInstance(
   // If not (or if none found), see if the spare RenderProcessHost can be used.
   auto& spare_process_manager = SpareRenderProcessHostManagerImpl::Get();
   bool spare_was_taken = false;
-  if (!render_process_host) {
+  // [FINGERPRINT] A spare has no identity of its own; only take it once the
+  // profile's identity can be sent to it ahead of the commit.
+  if (!render_process_host &&
+      FingerprintConfigService::Get().IsIdentityReady(browser_context)) {
     render_process_host = spare_process_manager.MaybeTakeSpare(
         browser_context, site_instance, allocation_context);
     if (render_process_host) {
@@ -5257,6 +5232,10 @@ RenderProcessHost* RenderProcessHostImpl::GetProcessHostForSiteInstance(
             site_instance->GetSiteURL()));
   }
 
+  // [FINGERPRINT] 备用进程 (spare) 启动时没有指纹身份，在分配给 profile 时
+  // 通过 Mojo 下发；已有身份的进程不受影响。
+  FingerprintConfigService::Get().BindIdentity(render_process_host);
+
   if (is_unmatched_service_worker) {
     UnmatchedServiceWorkerProcessTracker::Register(render_process_host,
                                                    site_instance);
@@ -24,6 +24,7 @@
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/discardable_memory_allocator.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/structured_shared_memory.h"
 #include "base/message_loop/message_pump.h"
@@ -123,7 +124,9 @@
 #include "media/video/gpu_video_accelerator_factories.h"
 #include "mojo/public/cpp/bindings/binder_map.h"
 #include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/self_owned_associated_receiver.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "mojo/public/cpp/system/message_pipe.h"
 #include "net/base/net_errors.h"
@@ -142,6 +145,7 @@
 #include "third_party/blink/public/common/switches.h"
 #include "third_party/blink/public/common/thread_safe_browser_interface_broker_proxy.h"
 #include "third_party/blink/public/mojom/cpu_performance.mojom.h"
+#include "third_party/blink/public/mojom/fingerprint/fingerprint_config.mojom.h"
 #include "third_party/blink/public/mojom/origin_trials/origin_trials_settings.mojom.h"
 #include "third_party/blink/public/platform/modules/video_capture/web_video_capture_impl_manager.h"
 #include "third_party/blink/public/platform/scheduler/web_thread_scheduler.h"
@@ -154,6 +158,7 @@
 #include "third_party/blink/public/platform/web_theme_engine.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
+#include "third_party/blink/public/web/web_fingerprint_config.h"
 #include "third_party/blink/public/web/web_frame.h"
 #include "third_party/blink/public/web/web_render_theme.h"
 #include "third_party/blink/public/web/web_security_policy.h"
@@ -295,6 +300,33 @@ bool IsBackgrounded(std::optional<base::Process::Priority> process_priority) {
   }
 }
 
+// [FINGERPRINT] Receives the identity of renderers launched without one
+// (spare renderers, or processes created while the identity was still
+// compiling), and the new snapshot when the identity file changes. Bound as a
+// channel-associated interface, so SetIdentity() is ordered with the
+// navigations sent after it: a spare gets it before its first commit, while a
+// process created during the compile may already have committed under the
+// placeholder config (see FingerprintConfig::LoadConfig()). Publishing also switches the process timezone when the
+// new identity's zone differs from the applied one.
+class FingerprintConfigAgentImpl : public blink::mojom::FingerprintConfigAgent {
+ public:
+  static void Bind(
+      mojo::PendingAssociatedReceiver<blink::mojom::FingerprintConfigAgent>
+          receiver) {
+    mojo::MakeSelfOwnedAssociatedReceiver(
+        std::make_unique<FingerprintConfigAgentImpl>(), std::move(receiver));
+  }
+
+  // blink::mojom::FingerprintConfigAgent:
+  void SetIdentity(base::ReadOnlySharedMemoryRegion image) override {
+    base::ReadOnlySharedMemoryMapping mapping = image.Map();
+    if (!mapping.IsValid() || !blink::PublishFingerprintConfigImage(
+                                  mapping.GetMemoryAsSpan<uint8_t>())) {
+      LOG(ERROR) << ">>> [FINGERPRINT] RENDERER: Invalid late-bound identity";
+    }
+  }
+};
+
 }  // namespace
 
 RenderThreadImpl::HistogramCustomizer::HistogramCustomizer() {
@@ -427,25 +459,9 @@ RenderThreadImpl::RenderThreadImpl(
       client_id_(client_id) {
 
           // ================= [FINGERPRINT DYNAMIC START] =================
-          // 1. ȡǰ̵
-          const base::CommandLine& command_line =
-              *base::CommandLine::ForCurrentProcess();
-
-          // 2. Ƿ "force-timezone" 
-          if (command_line.HasSwitch("force-timezone")) {
-            std::string tz_id = command_line.GetSwitchValueASCII("force-timezone");
-
-            if (!tz_id.empty()) {
-              // 3. ̬ V8 ָ
-              std::string v8_flag = "--timezone=" + tz_id;
-
-              // 4. Ӧ
-              v8::V8::SetFlagsFromString(v8_flag.c_str(), v8_flag.size());
-
-              LOG(ERROR) << ">>> [FINGERPRINT] RENDERER: V8 Flag set dynamically: "
-                         << v8_flag;
-            }
-          }
+          // ʱ (libc/ICU/V8 --timezone)  V8 ʼ֮ǰͳһӦһΣ
+          // ֮󴴽 frame ظá
+          blink::ApplyFingerprintTimezoneAtStartup();
           // ================= [FINGERPRINT DYNAMIC END] =================
 
           TRACE_EVENT0("startup", "RenderThreadImpl::Create");
@@ -530,6 +546,9 @@ void RenderThreadImpl::Init() {
   GetAssociatedInterfaceRegistry()->AddInterface<mojom::Renderer>(
       base::BindRepeating(&RenderThreadImpl::OnRendererInterfaceReceiver,
                           base::Unretained(this)));
+  GetAssociatedInterfaceRegistry()
+      ->AddInterface<blink::mojom::FingerprintConfigAgent>(
+          base::BindRepeating(&FingerprintConfigAgentImpl::Bind));
 
   const base::CommandLine& command_line =
       *base::CommandLine::ForCurrentProcess();
@@ -0,0 +1,910 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/public/common/fingerprint/fingerprint_config_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "base/compiler_specific.h"
+#include "base/hash/hash.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_gpu_profile_library.h"
+
+namespace blink {
+
+namespace {
+
+// Collects the string pool while the fixed-size part is being filled in.
+class StringPool {
+ public:
+  FingerprintConfigImageString Add(std::string_view value) {
+    FingerprintConfigImageString ref{
+        base::checked_cast<uint32_t>(bytes_.size()),
+        base::checked_cast<uint32_t>(value.size())};
+    bytes_.append(value);
+    return ref;
+  }
+
+  const std::string& bytes() const { return bytes_; }
+
+ private:
+  std::string bytes_;
+};
+
+void SetFlag(FingerprintConfigImage& image,
+             FingerprintConfigImage::Flag flag,
+             bool value) {
+  if (value) {
+    image.flags |= flag;
+  } else {
+    image.flags &= ~flag;
+  }
+}
+
+// The checksum covers everything after the |checksum| field itself.
+constexpr size_t kChecksummedOffset = offsetof(FingerprintConfigImage, flags);
+
+uint32_t ComputeChecksum(base::span<const uint8_t> image_bytes) {
+  return base::PersistentHash(image_bytes.subspan(kChecksummedOffset));
+}
+
+// Static WebGL limits a GPU profile may give, by their WebGL constant names.
+// Only limits that do not depend on context state belong here: the renderer
+// answers these from the profile without asking the GPU process.
+struct WebGLParameterSpec {
+  const char* name;
+  uint32_t pname;
+  uint32_t count;
+};
+
+constexpr WebGLParameterSpec kWebGLParameters[] = {
+    {"ALIASED_LINE_WIDTH_RANGE", 0x846E, 2},
+    {"ALIASED_POINT_SIZE_RANGE", 0x846D, 2},
+    {"MAX_COMBINED_TEXTURE_IMAGE_UNITS", 0x8B4D, 1},
+    {"MAX_CUBE_MAP_TEXTURE_SIZE", 0x851C, 1},
+    {"MAX_FRAGMENT_UNIFORM_VECTORS", 0x8DFD, 1},
+    {"MAX_RENDERBUFFER_SIZE", 0x84E8, 1},
+    {"MAX_TEXTURE_IMAGE_UNITS", 0x8872, 1},
+    {"MAX_TEXTURE_SIZE", 0x0D33, 1},
+    {"MAX_VARYING_VECTORS", 0x8DFC, 1},
+    {"MAX_VERTEX_ATTRIBS", 0x8869, 1},
+    {"MAX_VERTEX_TEXTURE_IMAGE_UNITS", 0x8B4C, 1},
+    {"MAX_VERTEX_UNIFORM_VECTORS", 0x8DFB, 1},
+    {"MAX_VIEWPORT_DIMS", 0x0D3A, 2},
+    {"SUBPIXEL_BITS", 0x0D50, 1},
+    {"MAX_TEXTURE_MAX_ANISOTROPY_EXT", 0x84FF, 1},
+    // WebGL 2.
+    {"MAX_3D_TEXTURE_SIZE", 0x8073, 1},
+    {"MAX_ARRAY_TEXTURE_LAYERS", 0x88FF, 1},
+    {"MAX_COLOR_ATTACHMENTS", 0x8CDF, 1},
+    {"MAX_COMBINED_UNIFORM_BLOCKS", 0x8A2E, 1},
+    {"MAX_DRAW_BUFFERS", 0x8824, 1},
+    {"MAX_ELEMENTS_INDICES", 0x80E9, 1},
+    {"MAX_ELEMENTS_VERTICES", 0x80E8, 1},
+    {"MAX_FRAGMENT_INPUT_COMPONENTS", 0x9125, 1},
+    {"MAX_FRAGMENT_UNIFORM_BLOCKS", 0x8A2D, 1},
+    {"MAX_FRAGMENT_UNIFORM_COMPONENTS", 0x8B49, 1},
+    {"MAX_PROGRAM_TEXEL_OFFSET", 0x8905, 1},
+    {"MIN_PROGRAM_TEXEL_OFFSET", 0x8904, 1},
+    {"MAX_SAMPLES", 0x8D57, 1},
+    {"MAX_TEXTURE_LOD_BIAS", 0x84FD, 1},
+    {"MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS", 0x8C8A, 1},
+    {"MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS", 0x8C8B, 1},
+    {"MAX_TRANSFORM_FEEDBACK_SEPARATE_COMPONENTS", 0x8C80, 1},
+    {"MAX_UNIFORM_BUFFER_BINDINGS", 0x8A2F, 1},
+    {"MAX_VARYING_COMPONENTS", 0x8B4B, 1},
+    {"MAX_VERTEX_OUTPUT_COMPONENTS", 0x9122, 1},
+    {"MAX_VERTEX_UNIFORM_BLOCKS", 0x8A2B, 1},
+    {"MAX_VERTEX_UNIFORM_COMPONENTS", 0x8B4A, 1},
+    {"UNIFORM_BUFFER_OFFSET_ALIGNMENT", 0x8A34, 1},
+};
+
+const WebGLParameterSpec* FindWebGLParameter(std::string_view name) {
+  for (const WebGLParameterSpec& spec : kWebGLParameters) {
+    if (name == spec.name) {
+      return &spec;
+    }
+  }
+  return nullptr;
+}
+
+// getShaderPrecisionFormat() argument names, in image index order.
+constexpr const char* kShaderTypeNames[] = {"VERTEX_SHADER",
+                                            "FRAGMENT_SHADER"};
+constexpr const char* kPrecisionTypeNames[] = {
+    "LOW_FLOAT", "MEDIUM_FLOAT", "HIGH_FLOAT",
+    "LOW_INT",   "MEDIUM_INT",   "HIGH_INT"};
+static_assert(std::size(kShaderTypeNames) ==
+              FingerprintConfigImage::kShaderTypes);
+static_assert(std::size(kPrecisionTypeNames) ==
+              FingerprintConfigImage::kPrecisionTypes);
+
+template <size_t N>
+std::optional<size_t> IndexOfName(const char* const (&names)[N],
+                                  std::string_view name) {
+  for (size_t i = 0; i < N; ++i) {
+    if (name == names[i]) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+// A parameter value: a number, or a list of |count| numbers. Returns false
+// if |value| is neither.
+bool ReadWebGLParameterValue(const base::Value& value,
+                             uint32_t count,
+                             FingerprintConfigImageWebGLParameter* out) {
+  if (count == 1 && (value.is_int() || value.is_double())) {
+    out->values[0] = value.GetDouble();
+    return true;
+  }
+  if (!value.is_list() || value.GetList().size() != count) {
+    return false;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const base::Value& item = value.GetList()[i];
+    if (!item.is_int() && !item.is_double()) {
+      return false;
+    }
+    // SAFETY: |count| <= kMaxValues for every entry of kWebGLParameters.
+    UNSAFE_BUFFERS(out->values[i]) = item.GetDouble();
+  }
+  return true;
+}
+
+// A precision entry: [rangeMin, rangeMax, precision].
+bool ReadShaderPrecision(const base::Value& value,
+                         FingerprintConfigImageShaderPrecision* out) {
+  if (!value.is_list() || value.GetList().size() != 3) {
+    return false;
+  }
+  int32_t numbers[3];
+  for (size_t i = 0; i < 3; ++i) {
+    const base::Value& item = value.GetList()[i];
+    if (!item.is_int() || item.GetInt() < 0 || item.GetInt() > 1024) {
+      return false;
+    }
+    numbers[i] = item.GetInt();
+  }
+  *out = {numbers[0], numbers[1], numbers[2]};
+  return true;
+}
+
+// fingerprint.json schema, one entry per accepted key. A null |section| means
+// a top-level key. Keep in sync with Compile().
+enum class KeyType {
+  kBool,
+  kInt,
+  kDouble,
+  kString,
+  kStringList,
+  // {"MAX_TEXTURE_SIZE": 16384, "MAX_VIEWPORT_DIMS": [32767, 32767], ...}
+  kWebGLParameters,
+  // {"VERTEX_SHADER": {"HIGH_FLOAT": [127, 127, 23], ...}, ...}
+  kShaderPrecisions,
+};
+
+struct KeySpec {
+  const char* section;
+  const char* key;
+  KeyType type;
+  double min;
+  double max;
+};
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr double kIntMin = std::numeric_limits<int>::min();
+constexpr double kIntMax = std::numeric_limits<int>::max();
+
+constexpr KeySpec kSchema[] = {
+    {nullptr, "global_seed", KeyType::kInt, kIntMin, kIntMax},
+
+    {"ua_config", "enabled", KeyType::kBool, 0, 0},
+    {"ua_config", "mobile", KeyType::kBool, 0, 0},
+    {"ua_config", "ua_string", KeyType::kString, 0, 0},
+    {"ua_config", "platform", KeyType::kString, 0, 0},
+    {"ua_config", "platform_version", KeyType::kString, 0, 0},
+    {"ua_config", "language", KeyType::kString, 0, 0},
+
+    {"webgl", "profile", KeyType::kString, 0, 0},
+    {"webgl", "vendor", KeyType::kString, 0, 0},
+    {"webgl", "renderer", KeyType::kString, 0, 0},
+    {"webgl", "clear_color_noise", KeyType::kDouble, 0, 1},
+    {"webgl", "viewport_noise_max", KeyType::kInt, 0, 1024},
+    {"webgl", "read_pixels_noise_max", KeyType::kInt, 0, 255},
+    {"webgl", "render_exact", KeyType::kBool, 0, 0},
+    {"webgl", "parameters", KeyType::kWebGLParameters, 0, 0},
+    {"webgl", "shader_precision", KeyType::kShaderPrecisions, 0, 0},
+    {"webgl", "extensions", KeyType::kStringList, 0, 0},
+    {"webgl", "antialias", KeyType::kBool, 0, 0},
+
+    {"hardware", "concurrency", KeyType::kInt, 1, 256},
+    {"hardware", "memory_gb", KeyType::kDouble, 0.25, 1024},
+
+    {"screen", "enable_spoofing", KeyType::kBool, 0, 0},
+    {"screen", "width", KeyType::kInt, 1, 16384},
+    {"screen", "height", KeyType::kInt, 1, 16384},
+    {"screen", "color_depth", KeyType::kInt, 1, 48},
+
+    {"canvas", "measure_text_noise_enable", KeyType::kBool, 0, 0},
+    {"canvas", "fill_text_offset_max", KeyType::kInt, 0, 100},
+
+    {"audio", "spoofing_enabled", KeyType::kBool, 0, 0},
+    {"audio", "sample_rate_offset_max", KeyType::kInt, 0, 10000},
+    {"audio", "sample_rate_offset", KeyType::kDouble, -10000, 10000},
+    {"audio", "reduction_noise_factor", KeyType::kDouble, 0, 1},
+
+    {"plugins", "description_noise_max", KeyType::kInt, 0, 100},
+
+    {"rects", "noise_factor", KeyType::kDouble, 0, 1},
+
+    {"fonts", "offset_noise_prob_percent", KeyType::kInt, 0, 100},
+    {"fonts", "whitelist", KeyType::kStringList, 0, 0},
+
+    {"network", "spoofing_enabled", KeyType::kBool, 0, 0},
+    {"network", "downlink", KeyType::kDouble, 0, 10000},
+    {"network", "rtt", KeyType::kDouble, 0, 60000},
+    {"network", "effective_type", KeyType::kString, 0, 0},
+    {"network", "save_data", KeyType::kBool, 0, 0},
+
+    {"battery", "spoofing_enabled", KeyType::kBool, 0, 0},
+    {"battery", "charging", KeyType::kBool, 0, 0},
+    {"battery", "charging_time", KeyType::kDouble, 0, kInf},
+    {"battery", "discharging_time", KeyType::kDouble, 0, kInf},
+    {"battery", "level", KeyType::kDouble, 0, 1},
+
+    {"webrtc", "prevent_ip_leak", KeyType::kBool, 0, 0},
+    {"webrtc", "device_label_noise_max", KeyType::kInt, 0, 100},
+
+    {"geo", "spoofing_enabled", KeyType::kBool, 0, 0},
+    {"geo", "latitude", KeyType::kDouble, -90, 90},
+    {"geo", "longitude", KeyType::kDouble, -180, 180},
+    {"geo", "accuracy", KeyType::kDouble, 0, 100000},
+
+    {"timezone", "spoofing_enabled", KeyType::kBool, 0, 0},
+    {"timezone", "zone_id", KeyType::kString, 0, 0},
+};
+
+const KeySpec* FindKeySpec(const char* section, std::string_view key) {
+  for (const KeySpec& spec : kSchema) {
+    const bool same_section =
+        section ? spec.section && std::string_view(spec.section) == section
+                : !spec.section;
+    if (same_section && key == spec.key) {
+      return &spec;
+    }
+  }
+  return nullptr;
+}
+
+bool IsKnownSection(std::string_view name) {
+  for (const KeySpec& spec : kSchema) {
+    if (spec.section && name == spec.section) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ValidateValue(const KeySpec& spec,
+                   const base::Value& value,
+                   std::vector<std::string>* errors) {
+  const std::string path = spec.section
+                               ? base::StrCat({spec.section, ".", spec.key})
+                               : std::string(spec.key);
+  switch (spec.type) {
+    case KeyType::kBool:
+      if (!value.is_bool()) {
+        errors->push_back(path + ": expected a boolean");
+      }
+      return;
+    case KeyType::kString:
+      if (!value.is_string()) {
+        errors->push_back(path + ": expected a string");
+      }
+      return;
+    case KeyType::kStringList:
+      if (!value.is_list()) {
+        errors->push_back(path + ": expected a list of strings");
+        return;
+      }
+      for (const base::Value& item : value.GetList()) {
+        if (!item.is_string()) {
+          errors->push_back(path + ": expected a list of strings");
+          return;
+        }
+      }
+      return;
+    case KeyType::kWebGLParameters:
+      if (!value.is_dict()) {
+        errors->push_back(path + ": expected an object");
+        return;
+      }
+      for (const auto [name, item] : value.GetDict()) {
+        const WebGLParameterSpec* parameter = FindWebGLParameter(name);
+        FingerprintConfigImageWebGLParameter unused;
+        if (!parameter) {
+          errors->push_back(base::StrCat(
+              {path, ".", name, ": not a static WebGL limit"}));
+        } else if (!ReadWebGLParameterValue(item, parameter->count,
+                                            &unused)) {
+          errors->push_back(base::StrCat(
+              {path, ".", name, ": expected ",
+               parameter->count == 1
+                   ? std::string("a number")
+                   : base::StrCat({"a list of ",
+                                   base::NumberToString(parameter->count),
+                                   " numbers"})}));
+        }
+      }
+      return;
+    case KeyType::kShaderPrecisions:
+      if (!value.is_dict()) {
+        errors->push_back(path + ": expected an object");
+        return;
+      }
+      for (const auto [shader, precisions] : value.GetDict()) {
+        if (!IndexOfName(kShaderTypeNames, shader)) {
+          errors->push_back(base::StrCat({path, ".", shader,
+                                          ": expected VERTEX_SHADER or "
+                                          "FRAGMENT_SHADER"}));
+          continue;
+        }
+        if (!precisions.is_dict()) {
+          errors->push_back(
+              base::StrCat({path, ".", shader, ": expected an object"}));
+          continue;
+        }
+        for (const auto [precision, item] : precisions.GetDict()) {
+          FingerprintConfigImageShaderPrecision unused;
+          if (!IndexOfName(kPrecisionTypeNames, precision)) {
+            errors->push_back(base::StrCat(
+                {path, ".", shader, ".", precision, ": unknown precision"}));
+          } else if (!ReadShaderPrecision(item, &unused)) {
+            errors->push_back(
+                base::StrCat({path, ".", shader, ".", precision,
+                              ": expected [rangeMin, rangeMax, precision]"}));
+          }
+        }
+      }
+      return;
+    case KeyType::kInt:
+      if (!value.is_int()) {
+        errors->push_back(path + ": expected an integer");
+        return;
+      }
+      break;
+    case KeyType::kDouble:
+      if (!value.is_int() && !value.is_double()) {
+        errors->push_back(path + ": expected a number");
+        return;
+      }
+      break;
+  }
+  const double number = value.GetDouble();
+  if (!(number >= spec.min && number <= spec.max)) {
+    errors->push_back(base::StrCat(
+        {path, ": ", base::NumberToString(number), " is out of range [",
+         base::NumberToString(spec.min), ", ", base::NumberToString(spec.max),
+         "]"}));
+  }
+}
+
+}  // namespace
+
+// static
+std::vector<uint8_t> FingerprintConfigImage::Compile(
+    const base::Value::Dict& root,
+    const FingerprintGpuProfileLibrary* gpu_profiles) {
+  FingerprintConfigImage image = {};
+  image.magic = kMagic;
+  image.version = kVersion;
+
+  // Built-in defaults, used for every section missing from |root|.
+  std::string ua_string;
+  std::string ua_platform = "Win32";
+  std::string ua_platform_version = "13.0.0";
+  std::string ua_language = "en-US";
+  std::string webgl_vendor = "Google Inc. (NVIDIA)";
+  std::string webgl_renderer =
+      "ANGLE (NVIDIA, NVIDIA GeForce RTX 4090 Direct3D11, vs_5_0, ps_5_0)";
+  std::string network_effective_type = "4g";
+  std::string timezone_zone_id = "America/New_York";
+  std::vector<std::string> fonts;
+  std::vector<FingerprintConfigImageWebGLParameter> webgl_parameters;
+  std::vector<std::string> webgl_extensions;
+
+  image.rects_noise_factor = 0.000005;
+  image.geo_latitude = 51.5074;
+  image.geo_longitude = -0.1278;
+  image.geo_accuracy = 10.0;
+  image.battery_charging_time = 0.0;
+  image.battery_discharging_time = 0.0;
+  image.battery_level = 1.0;
+  image.network_downlink = 10.0;
+  image.network_rtt = 50.0;
+  image.audio_sample_rate_offset = 0.0;
+  image.audio_reduction_noise_factor = 0.001;
+  image.webgl_clear_color_noise = 0.005f;
+  image.device_memory = 32.0f;
+  image.global_seed = root.FindInt("global_seed").value_or(0);
+  image.webgl_viewport_noise_max = 15;
+  image.webgl_read_pixels_noise_max = 3;
+  image.hardware_concurrency = 16;
+  image.screen_width = 0;
+  image.screen_height = 0;
+  image.screen_color_depth = 24;
+  image.canvas_fill_text_offset_max = 3;
+  image.fonts_offset_noise_prob_percent = 0;
+  image.plugins_description_noise_max = 9;
+  image.webrtc_device_label_noise_max = 9;
+  image.audio_sample_rate_offset_max = 99;
+  image.flags = kBatteryCharging | kWebRTCPreventIpLeak | kGeoSpoofing |
+                kCanvasMeasureTextNoise;
+
+  // [UA]
+  if (const auto* ua = root.FindDict("ua_config")) {
+    SetFlag(image, kUAEnabled, ua->FindBool("enabled").value_or(false));
+    if (const std::string* s = ua->FindString("ua_string")) {
+      ua_string = *s;
+    }
+    SetFlag(image, kUAMobile, ua->FindBool("mobile").value_or(false));
+    if (const std::string* s = ua->FindString("platform")) {
+      ua_platform = *s;
+    }
+    if (const std::string* s = ua->FindString("platform_version")) {
+      ua_platform_version = *s;
+    }
+    if (const std::string* s = ua->FindString("language")) {
+      ua_language = *s;
+    }
+  }
+
+  // [WebGL]
+  if (const auto* webgl = root.FindDict("webgl")) {
+    // A library profile first, so that the keys below can override it.
+    const std::string* profile_name = webgl->FindString("profile");
+    if (const FingerprintConfigImage* profile =
+            profile_name && gpu_profiles ? gpu_profiles->Find(*profile_name)
+                                         : nullptr) {
+      webgl_vendor = profile->GetString(profile->webgl_vendor);
+      webgl_renderer = profile->GetString(profile->webgl_renderer);
+      const auto parameters = profile->GetWebGLParameters();
+      webgl_parameters.assign(parameters.begin(), parameters.end());
+      image.webgl_shader_precision_mask = profile->webgl_shader_precision_mask;
+      base::byte_span_from_ref(image.webgl_shader_precisions)
+          .copy_from(
+              base::byte_span_from_ref(profile->webgl_shader_precisions));
+      for (size_t i = 0; i < profile->webgl_extension_count(); ++i) {
+        webgl_extensions.emplace_back(profile->GetWebGLExtension(i));
+      }
+      image.flags |= profile->flags & (kWebGLExtensions | kWebGLAntialiasSet |
+                                       kWebGLAntialias);
+    }
+    if (const std::string* s = webgl->FindString("vendor")) {
+      webgl_vendor = *s;
+    }
+    if (const std::string* s = webgl->FindString("renderer")) {
+      webgl_renderer = *s;
+    }
+    image.webgl_clear_color_noise = static_cast<float>(
+        webgl->FindDouble("clear_color_noise").value_or(0.005));
+    image.webgl_viewport_noise_max =
+        webgl->FindInt("viewport_noise_max").value_or(15);
+    image.webgl_read_pixels_noise_max =
+        webgl->FindInt("read_pixels_noise_max").value_or(3);
+    SetFlag(image, kWebGLRenderExact,
+            webgl->FindBool("render_exact").value_or(false));
+
+    // GPU profile. Entries Validate() would reject are skipped.
+    if (const auto* parameters = webgl->FindDict("parameters")) {
+      for (const auto [name, value] : *parameters) {
+        const WebGLParameterSpec* spec = FindWebGLParameter(name);
+        FingerprintConfigImageWebGLParameter parameter = {};
+        if (!spec ||
+            !ReadWebGLParameterValue(value, spec->count, &parameter)) {
+          continue;
+        }
+        parameter.pname = spec->pname;
+        parameter.count = spec->count;
+        auto it = std::ranges::find(
+            webgl_parameters, spec->pname,
+            &FingerprintConfigImageWebGLParameter::pname);
+        if (it != webgl_parameters.end()) {
+          *it = parameter;
+        } else {
+          webgl_parameters.push_back(parameter);
+        }
+      }
+      std::ranges::sort(webgl_parameters, {},
+                        &FingerprintConfigImageWebGLParameter::pname);
+    }
+    if (const auto* shaders = webgl->FindDict("shader_precision")) {
+      for (const auto [shader, precisions] : *shaders) {
+        const std::optional<size_t> shader_index =
+            IndexOfName(kShaderTypeNames, shader);
+        if (!shader_index || !precisions.is_dict()) {
+          continue;
+        }
+        for (const auto [precision, value] : precisions.GetDict()) {
+          const std::optional<size_t> precision_index =
+              IndexOfName(kPrecisionTypeNames, precision);
+          FingerprintConfigImageShaderPrecision entry;
+          if (!precision_index || !ReadShaderPrecision(value, &entry)) {
+            continue;
+          }
+          // SAFETY: both indices come from the fixed-size name tables.
+          UNSAFE_BUFFERS(
+              image.webgl_shader_precisions[*shader_index][*precision_index]) =
+              entry;
+          image.webgl_shader_precision_mask |=
+              1u << (*shader_index * kPrecisionTypes + *precision_index);
+        }
+      }
+    }
+    if (const auto* extensions = webgl->FindList("extensions")) {
+      image.flags |= kWebGLExtensions;
+      webgl_extensions.clear();
+      for (const auto& value : *extensions) {
+        if (value.is_string()) {
+          webgl_extensions.push_back(value.GetString());
+        }
+      }
+    }
+    if (std::optional<bool> antialias = webgl->FindBool("antialias")) {
+      image.flags |= kWebGLAntialiasSet;
+      SetFlag(image, kWebGLAntialias, *antialias);
+    }
+  }
+
+  // [Hardware] Normalized here once instead of on every child start.
+  if (const auto* hw = root.FindDict("hardware")) {
+    // Logical core counts are virtually always even; round odd values up.
+    int cpu_val = hw->FindInt("concurrency").value_or(16);
+    if (cpu_val > 0 && cpu_val % 2 != 0) {
+      cpu_val += 1;
+    }
+    image.hardware_concurrency = cpu_val;
+
+    // navigator.deviceMemory only exposes powers of two; round down.
+    double mem_val = hw->FindDouble("memory_gb").value_or(32.0);
+    if (mem_val > 0) {
+      mem_val = std::pow(2, std::floor(std::log2(mem_val)));
+    }
+    image.device_memory = static_cast<float>(mem_val);
+  }
+
+  // [Screen]
+  if (const auto* scr = root.FindDict("screen")) {
+    SetFlag(image, kScreenEnabled,
+            scr->FindBool("enable_spoofing").value_or(false));
+    image.screen_width = scr->FindInt("width").value_or(1920);
+    image.screen_height = scr->FindInt("height").value_or(1080);
+    image.screen_color_depth = scr->FindInt("color_depth").value_or(24);
+  }
+
+  // [Canvas]
+  if (const auto* cvs = root.FindDict("canvas")) {
+    SetFlag(image, kCanvasMeasureTextNoise,
+            cvs->FindBool("measure_text_noise_enable").value_or(true));
+    image.canvas_fill_text_offset_max =
+        cvs->FindInt("fill_text_offset_max").value_or(3);
+  }
+
+  // [Audio]
+  if (const auto* aud = root.FindDict("audio")) {
+    image.audio_sample_rate_offset_max =
+        aud->FindInt("sample_rate_offset_max").value_or(100);
+    SetFlag(image, kAudioSpoofing,
+            aud->FindBool("spoofing_enabled").value_or(false));
+    image.audio_sample_rate_offset =
+        aud->FindDouble("sample_rate_offset").value_or(0.0);
+    image.audio_reduction_noise_factor =
+        aud->FindDouble("reduction_noise_factor").value_or(0.001);
+  }
+
+  // [Plugins]
+  if (const auto* plg = root.FindDict("plugins")) {
+    image.plugins_description_noise_max =
+        plg->FindInt("description_noise_max").value_or(5);
+  }
+
+  // [Rects]
+  if (const auto* rects = root.FindDict("rects")) {
+    image.rects_noise_factor =
+        rects->FindDouble("noise_factor").value_or(0.000005);
+  }
+
+  // [Fonts]
+  if (const auto* fonts_node = root.FindDict("fonts")) {
+    image.fonts_offset_noise_prob_percent =
+        fonts_node->FindInt("offset_noise_prob_percent").value_or(10);
+    if (const auto* whitelist = fonts_node->FindList("whitelist")) {
+      for (const auto& value : *whitelist) {
+        if (value.is_string()) {
+          fonts.push_back(value.GetString());
+        }
+      }
+    }
+  }
+
+  // [Network]
+  if (const auto* net = root.FindDict("network")) {
+    SetFlag(image, kNetworkSpoofing,
+            net->FindBool("spoofing_enabled").value_or(true));
+    image.network_downlink = net->FindDouble("downlink").value_or(10.0);
+    image.network_rtt = net->FindDouble("rtt").value_or(50.0);
+    if (const std::string* s = net->FindString("effective_type")) {
+      network_effective_type = *s;
+    }
+    SetFlag(image, kNetworkSaveData,
+            net->FindBool("save_data").value_or(false));
+  }
+
+  // [Battery]
+  if (const auto* bat = root.FindDict("battery")) {
+    SetFlag(image, kBatterySpoofing,
+            bat->FindBool("spoofing_enabled").value_or(true));
+    SetFlag(image, kBatteryCharging,
+            bat->FindBool("charging").value_or(true));
+    image.battery_charging_time =
+        bat->FindDouble("charging_time").value_or(0.0);
+    image.battery_discharging_time =
+        bat->FindDouble("discharging_time")
+            .value_or(std::numeric_limits<double>::infinity());
+    image.battery_level = bat->FindDouble("level").value_or(1.0);
+  }
+
+  // [WebRTC]
+  if (const auto* rtc = root.FindDict("webrtc")) {
+    SetFlag(image, kWebRTCPreventIpLeak,
+            rtc->FindBool("prevent_ip_leak").value_or(true));
+    image.webrtc_device_label_noise_max =
+        rtc->FindInt("device_label_noise_max").value_or(5);
+  }
+
+  // [Geo]
+  if (const auto* geo = root.FindDict("geo")) {
+    SetFlag(image, kGeoSpoofing,
+            geo->FindBool("spoofing_enabled").value_or(true));
+    image.geo_latitude = geo->FindDouble("latitude").value_or(51.5074);
+    image.geo_longitude = geo->FindDouble("longitude").value_or(-0.1278);
+    image.geo_accuracy = geo->FindDouble("accuracy").value_or(10.0);
+  }
+  if (image.HasFlag(kGeoSpoofing) && image.geo_latitude == 0 &&
+      image.geo_longitude == 0) {
+    image.geo_latitude = 51.5074;
+    image.geo_longitude = -0.1278;
+  }
+
+  // [Timezone]
+  if (const auto* tz = root.FindDict("timezone")) {
+    SetFlag(image, kTimezoneSpoofing,
+            tz->FindBool("spoofing_enabled").value_or(true));
+    if (const std::string* s = tz->FindString("zone_id")) {
+      timezone_zone_id = *s;
+    }
+  }
+  if (image.HasFlag(kTimezoneSpoofing) && timezone_zone_id.empty()) {
+    timezone_zone_id = "Europe/London";
+  }
+
+  // Lay out [header][font refs][WebGL parameters][extension refs]
+  // [string pool].
+  const size_t fonts_offset = sizeof(FingerprintConfigImage);
+  const size_t parameters_offset =
+      fonts_offset + fonts.size() * sizeof(FingerprintConfigImageString);
+  const size_t extensions_offset =
+      parameters_offset +
+      webgl_parameters.size() * sizeof(FingerprintConfigImageWebGLParameter);
+  const size_t pool_offset =
+      extensions_offset +
+      webgl_extensions.size() * sizeof(FingerprintConfigImageString);
+  StringPool pool;
+  auto add = [&](const std::string& value) {
+    FingerprintConfigImageString ref = pool.Add(value);
+    ref.offset += base::checked_cast<uint32_t>(pool_offset);
+    return ref;
+  };
+  image.ua_string = add(ua_string);
+  image.ua_platform = add(ua_platform);
+  image.ua_platform_version = add(ua_platform_version);
+  image.ua_language = add(ua_language);
+  image.webgl_vendor = add(webgl_vendor);
+  image.webgl_renderer = add(webgl_renderer);
+  image.network_effective_type = add(network_effective_type);
+  image.timezone_zone_id = add(timezone_zone_id);
+  image.font_whitelist = {base::checked_cast<uint32_t>(fonts_offset),
+                          base::checked_cast<uint32_t>(fonts.size())};
+  std::vector<FingerprintConfigImageString> font_refs;
+  font_refs.reserve(fonts.size());
+  for (const std::string& font : fonts) {
+    font_refs.push_back(add(font));
+  }
+  image.webgl_parameters = {
+      base::checked_cast<uint32_t>(parameters_offset),
+      base::checked_cast<uint32_t>(webgl_parameters.size())};
+  image.webgl_extensions = {
+      base::checked_cast<uint32_t>(extensions_offset),
+      base::checked_cast<uint32_t>(webgl_extensions.size())};
+  std::vector<FingerprintConfigImageString> extension_refs;
+  extension_refs.reserve(webgl_extensions.size());
+  for (const std::string& extension : webgl_extensions) {
+    extension_refs.push_back(add(extension));
+  }
+  image.total_size =
+      base::checked_cast<uint32_t>(pool_offset + pool.bytes().size());
+
+  std::vector<uint8_t> bytes(image.total_size);
+  base::span<uint8_t> out(bytes);
+  out.first(sizeof(image)).copy_from(base::byte_span_from_ref(image));
+  out.subspan(fonts_offset, parameters_offset - fonts_offset)
+      .copy_from(base::as_byte_span(font_refs));
+  out.subspan(parameters_offset, extensions_offset - parameters_offset)
+      .copy_from(base::as_byte_span(webgl_parameters));
+  out.subspan(extensions_offset, pool_offset - extensions_offset)
+      .copy_from(base::as_byte_span(extension_refs));
+  out.subspan(pool_offset).copy_from(base::as_byte_span(pool.bytes()));
+  const uint32_t checksum = ComputeChecksum(bytes);
+  out.subspan(offsetof(FingerprintConfigImage, checksum), sizeof(checksum))
+      .copy_from(base::byte_span_from_ref(checksum));
+  return bytes;
+}
+
+// static
+bool FingerprintConfigImage::Validate(const base::Value::Dict& root,
+                                      std::vector<std::string>* errors) {
+  const size_t error_count = errors->size();
+  for (const auto [name, value] : root) {
+    if (const KeySpec* spec = FindKeySpec(nullptr, name)) {
+      ValidateValue(*spec, value, errors);
+      continue;
+    }
+    if (!IsKnownSection(name)) {
+      errors->push_back(name + ": unknown key");
+      continue;
+    }
+    if (!value.is_dict()) {
+      errors->push_back(name + ": expected an object");
+      continue;
+    }
+    for (const auto [key, item] : value.GetDict()) {
+      if (const KeySpec* spec = FindKeySpec(name.c_str(), key)) {
+        ValidateValue(*spec, item, errors);
+      } else {
+        errors->push_back(base::StrCat({name, ".", key, ": unknown key"}));
+      }
+    }
+  }
+  return errors->size() == error_count;
+}
+
+// static
+const FingerprintConfigImage* FingerprintConfigImage::FromBytes(
+    base::span<const uint8_t> bytes) {
+  if (bytes.size() < sizeof(FingerprintConfigImage) ||
+      reinterpret_cast<uintptr_t>(bytes.data()) %
+              alignof(FingerprintConfigImage) !=
+          0) {
+    return nullptr;
+  }
+  const auto* image =
+      reinterpret_cast<const FingerprintConfigImage*>(bytes.data());
+  // Shared-memory regions may be padded up to the page size, so only require
+  // that the declared size fits.
+  if (image->magic != kMagic || image->version != kVersion ||
+      image->total_size < sizeof(FingerprintConfigImage) ||
+      image->total_size > bytes.size()) {
+    return nullptr;
+  }
+  auto array_fits = [image](const FingerprintConfigImageString& array,
+                           size_t element_size, size_t alignment) {
+    const uint64_t end = static_cast<uint64_t>(array.offset) +
+                         static_cast<uint64_t>(array.length) * element_size;
+    return end <= image->total_size && array.offset % alignment == 0;
+  };
+  if (!array_fits(image->font_whitelist, sizeof(FingerprintConfigImageString),
+                  alignof(FingerprintConfigImageString)) ||
+      !array_fits(image->webgl_parameters,
+                  sizeof(FingerprintConfigImageWebGLParameter),
+                  alignof(FingerprintConfigImageWebGLParameter)) ||
+      !array_fits(image->webgl_extensions,
+                  sizeof(FingerprintConfigImageString),
+                  alignof(FingerprintConfigImageString))) {
+    return nullptr;
+  }
+  return image;
+}
+
+// static
+const FingerprintConfigImage* FingerprintConfigImage::FromBytesVerified(
+    base::span<const uint8_t> bytes) {
+  const FingerprintConfigImage* image = FromBytes(bytes);
+  if (!image || ComputeChecksum(bytes.first(image->total_size)) !=
+                    image->checksum) {
+    return nullptr;
+  }
+  return image;
+}
+
+std::string_view FingerprintConfigImage::GetString(
+    const FingerprintConfigImageString& ref) const {
+  const uint64_t end =
+      static_cast<uint64_t>(ref.offset) + static_cast<uint64_t>(ref.length);
+  if (end > total_size) {
+    return std::string_view();
+  }
+  // SAFETY: |ref| was bounds-checked against |total_size| above, which
+  // FromBytes() verified against the backing span.
+  return UNSAFE_BUFFERS(std::string_view(
+      reinterpret_cast<const char*>(this) + ref.offset, ref.length));
+}
+
+std::string_view FingerprintConfigImage::GetFont(size_t index) const {
+  if (index >= font_count()) {
+    return std::string_view();
+  }
+  // SAFETY: FromBytes() checked that the font array fits in the image.
+  const auto* refs = UNSAFE_BUFFERS(
+      reinterpret_cast<const FingerprintConfigImageString*>(
+          reinterpret_cast<const char*>(this) + font_whitelist.offset));
+  return GetString(UNSAFE_BUFFERS(refs[index]));
+}
+
+base::span<const FingerprintConfigImageWebGLParameter>
+FingerprintConfigImage::GetWebGLParameters() const {
+  // SAFETY: FromBytes() checked that the parameter array fits in the image.
+  return UNSAFE_BUFFERS(base::span(
+      reinterpret_cast<const FingerprintConfigImageWebGLParameter*>(
+          reinterpret_cast<const char*>(this) + webgl_parameters.offset),
+      webgl_parameters.length));
+}
+
+std::string_view FingerprintConfigImage::GetWebGLExtension(
+    size_t index) const {
+  if (index >= webgl_extension_count()) {
+    return std::string_view();
+  }
+  // SAFETY: FromBytes() checked that the extension array fits in the image.
+  const auto* refs = UNSAFE_BUFFERS(
+      reinterpret_cast<const FingerprintConfigImageString*>(
+          reinterpret_cast<const char*>(this) + webgl_extensions.offset));
+  return GetString(UNSAFE_BUFFERS(refs[index]));
+}
+
+const FingerprintConfigImageShaderPrecision*
+FingerprintConfigImage::GetShaderPrecision(uint32_t shader_type,
+                                           uint32_t precision_type) const {
+  constexpr uint32_t kFragmentShader = 0x8B30;
+  constexpr uint32_t kVertexShader = 0x8B31;
+  constexpr uint32_t kLowFloat = 0x8DF0;
+  size_t shader;
+  if (shader_type == kVertexShader) {
+    shader = 0;
+  } else if (shader_type == kFragmentShader) {
+    shader = 1;
+  } else {
+    return nullptr;
+  }
+  const size_t precision = precision_type - kLowFloat;
+  if (precision_type < kLowFloat || precision >= kPrecisionTypes ||
+      !(webgl_shader_precision_mask &
+        (1u << (shader * kPrecisionTypes + precision)))) {
+    return nullptr;
+  }
+  // SAFETY: both indices were range-checked above.
+  return &UNSAFE_BUFFERS(webgl_shader_precisions[shader][precision]);
+}
+
+}  // namespace blink
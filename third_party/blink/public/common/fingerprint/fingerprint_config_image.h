@@ -0,0 +1,212 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_CONFIG_IMAGE_H_
+#define THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_CONFIG_IMAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/values.h"
+#include "third_party/blink/public/common/common_export.h"
+
+namespace blink {
+
+struct FingerprintGpuProfileLibrary;
+
+// Key under which the browser shares the compiled image with renderers through
+// base::FileDescriptorStore (POSIX, non-Mac).
+inline constexpr char kFingerprintConfigImageDescriptorKey[] =
+    "fingerprint_config_image";
+
+// Switch carrying the Base64-encoded image on platforms where the read-only
+// region cannot be handed over as a preloaded descriptor.
+inline constexpr char kFingerprintConfigImageSwitch[] =
+    "fingerprint-config-image";
+
+// Switch marking a renderer launched without its identity (a spare, or one
+// launched while the identity was still compiling). The identity follows over
+// blink::mojom::FingerprintConfigAgent, so the renderer must not fall back to
+// reading fingerprint.json or to the built-in default identity.
+inline constexpr char kFingerprintIdentityPendingSwitch[] =
+    "fingerprint-identity-pending";
+
+// A string stored in the image: |offset| is relative to the image start.
+struct FingerprintConfigImageString {
+  uint32_t offset;
+  uint32_t length;
+};
+
+// One static WebGL limit of the identity's GPU profile, as getParameter()
+// returns it: a scalar (|count| 1) or a small array.
+struct FingerprintConfigImageWebGLParameter {
+  static constexpr size_t kMaxValues = 4;
+
+  uint32_t pname;
+  uint32_t count;
+  double values[kMaxValues];
+};
+
+// getShaderPrecisionFormat() result.
+struct FingerprintConfigImageShaderPrecision {
+  int32_t range_min;
+  int32_t range_max;
+  int32_t precision;
+};
+
+// Compact, pointer-free layout of fingerprint.json. The browser parses the JSON
+// once and compiles it into this layout (all normalization already applied);
+// children map the bytes read-only and only validate the fixed-size header.
+// Identities can also be compiled offline by //tools/fingerprint and shipped
+// as .fpci files, which carry a checksum over everything after it.
+//
+// Layout: [FingerprintConfigImage][FingerprintConfigImageString fonts[]]
+//         [FingerprintConfigImageWebGLParameter webgl_parameters[]]
+//         [FingerprintConfigImageString webgl_extensions[]][string bytes]
+struct BLINK_COMMON_EXPORT FingerprintConfigImage {
+  static constexpr uint32_t kMagic = 0x49435046u;  // "FPCI"
+  static constexpr uint32_t kVersion = 3u;
+
+  // getShaderPrecisionFormat() arguments: VERTEX_SHADER and FRAGMENT_SHADER,
+  // then LOW_FLOAT through HIGH_INT.
+  static constexpr size_t kShaderTypes = 2;
+  static constexpr size_t kPrecisionTypes = 6;
+
+  enum Flag : uint32_t {
+    kUAEnabled = 1u << 0,
+    kUAMobile = 1u << 1,
+    kScreenEnabled = 1u << 2,
+    kCanvasMeasureTextNoise = 1u << 3,
+    kNetworkSpoofing = 1u << 4,
+    kNetworkSaveData = 1u << 5,
+    kBatterySpoofing = 1u << 6,
+    kBatteryCharging = 1u << 7,
+    kWebRTCPreventIpLeak = 1u << 8,
+    kTimezoneSpoofing = 1u << 9,
+    kGeoSpoofing = 1u << 10,
+    kAudioSpoofing = 1u << 11,
+    // The GPU profile gives an extension list / the antialias attribute.
+    kWebGLExtensions = 1u << 12,
+    kWebGLAntialiasSet = 1u << 13,
+    kWebGLAntialias = 1u << 14,
+    // Draw-state calls reach the GPU untouched; noise only at readbacks.
+    kWebGLRenderExact = 1u << 15,
+  };
+
+  // Compiles the parsed fingerprint.json |root| into an image. Missing
+  // sections keep the built-in defaults; unknown keys and out-of-range values
+  // are not rejected here, see Validate(). A "webgl.profile" found in
+  // |gpu_profiles| supplies the GPU part of the webgl section; keys given
+  // next to it override the profile's values.
+  static std::vector<uint8_t> Compile(
+      const base::Value::Dict& root,
+      const FingerprintGpuProfileLibrary* gpu_profiles = nullptr);
+
+  // Checks |root| against the fingerprint.json schema: every key must be
+  // known, of the right type and within range. Appends one message per
+  // problem to |errors| and returns true if there were none.
+  static bool Validate(const base::Value::Dict& root,
+                       std::vector<std::string>* errors);
+
+  // Returns the image stored in |bytes| or nullptr if the header does not
+  // match. Only the header is checked, so this is O(1) in the image size;
+  // string accessors bounds-check lazily.
+  static const FingerprintConfigImage* FromBytes(
+      base::span<const uint8_t> bytes);
+
+  // Like FromBytes(), but also verifies |checksum|. O(n); meant for images
+  // read from disk, not for the shared-memory copy handed to children.
+  static const FingerprintConfigImage* FromBytesVerified(
+      base::span<const uint8_t> bytes);
+
+  bool HasFlag(Flag flag) const { return (flags & flag) != 0; }
+  std::string_view GetString(const FingerprintConfigImageString& ref) const;
+  size_t font_count() const { return font_whitelist.length; }
+  std::string_view GetFont(size_t index) const;
+  base::span<const FingerprintConfigImageWebGLParameter> GetWebGLParameters()
+      const;
+  size_t webgl_extension_count() const { return webgl_extensions.length; }
+  std::string_view GetWebGLExtension(size_t index) const;
+  // The profile's entry for |shader_type| / |precision_type| (GL enums), or
+  // nullptr if it has none.
+  const FingerprintConfigImageShaderPrecision* GetShaderPrecision(
+      uint32_t shader_type,
+      uint32_t precision_type) const;
+
+  // Header. |checksum| is base::PersistentHash() of the bytes from |flags| up
+  // to |total_size|.
+  uint32_t magic;
+  uint32_t version;
+  uint32_t total_size;
+  uint32_t checksum;
+  uint32_t flags;
+  uint32_t reserved;
+
+  // Scalars.
+  double rects_noise_factor;
+  double geo_latitude;
+  double geo_longitude;
+  double geo_accuracy;
+  double battery_charging_time;
+  double battery_discharging_time;
+  double battery_level;
+  double network_downlink;
+  double network_rtt;
+  double audio_sample_rate_offset;
+  double audio_reduction_noise_factor;
+  float webgl_clear_color_noise;
+  float device_memory;
+  int32_t global_seed;
+  int32_t webgl_viewport_noise_max;
+  int32_t webgl_read_pixels_noise_max;
+  int32_t hardware_concurrency;
+  int32_t screen_width;
+  int32_t screen_height;
+  int32_t screen_color_depth;
+  int32_t canvas_fill_text_offset_max;
+  int32_t fonts_offset_noise_prob_percent;
+  int32_t plugins_description_noise_max;
+  int32_t webrtc_device_label_noise_max;
+  int32_t audio_sample_rate_offset_max;
+
+  // Strings.
+  FingerprintConfigImageString ua_string;
+  FingerprintConfigImageString ua_platform;
+  FingerprintConfigImageString ua_platform_version;
+  FingerprintConfigImageString ua_language;
+  FingerprintConfigImageString webgl_vendor;
+  FingerprintConfigImageString webgl_renderer;
+  FingerprintConfigImageString network_effective_type;
+  FingerprintConfigImageString timezone_zone_id;
+  // |offset| points at an array of |length| FingerprintConfigImageString.
+  FingerprintConfigImageString font_whitelist;
+
+  // WebGL GPU profile; every part is optional. Bit
+  // (shader * kPrecisionTypes + precision) of |webgl_shader_precision_mask|
+  // tells whether that entry of |webgl_shader_precisions| is given.
+  uint32_t webgl_shader_precision_mask;
+  uint32_t reserved2;
+  FingerprintConfigImageShaderPrecision
+      webgl_shader_precisions[kShaderTypes][kPrecisionTypes];
+  // |offset| points at an array of |length|
+  // FingerprintConfigImageWebGLParameter, sorted by pname.
+  FingerprintConfigImageString webgl_parameters;
+  // |offset| points at an array of |length| FingerprintConfigImageString.
+  FingerprintConfigImageString webgl_extensions;
+};
+
+static_assert(std::is_trivially_copyable_v<FingerprintConfigImage>);
+static_assert(
+    std::is_trivially_copyable_v<FingerprintConfigImageWebGLParameter>);
+static_assert(sizeof(FingerprintConfigImage) % 8 == 0);
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_CONFIG_IMAGE_H_
@@ -0,0 +1,274 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/public/common/fingerprint/fingerprint_gpu_profile_library.h"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bits.h"
+#include "base/compiler_specific.h"
+#include "base/hash/hash.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace blink {
+
+namespace {
+
+// Keys of a profile besides "name": the parts of the webgl section that
+// describe the GPU rather than the noise.
+constexpr std::string_view kProfileKeys[] = {
+    "vendor",           "renderer",   "parameters",
+    "shader_precision", "extensions", "antialias",
+};
+
+bool IsProfileKey(std::string_view key) {
+  for (std::string_view profile_key : kProfileKeys) {
+    if (key == profile_key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t HashName(std::string_view name) {
+  return base::PersistentHash(base::as_byte_span(name));
+}
+
+// The checksum covers everything after the |checksum| field itself.
+constexpr size_t kChecksummedOffset =
+    offsetof(FingerprintGpuProfileLibrary, entries);
+
+uint32_t ComputeChecksum(base::span<const uint8_t> library_bytes) {
+  return base::PersistentHash(library_bytes.subspan(kChecksummedOffset));
+}
+
+base::span<const uint8_t> LibraryBytes(
+    const FingerprintGpuProfileLibrary& library) {
+  // SAFETY: FromBytesVerified() checked that |total_size| bytes are mapped.
+  return UNSAFE_BUFFERS(base::span(
+      reinterpret_cast<const uint8_t*>(&library), library.total_size));
+}
+
+template <typename T>
+base::span<const T> ArrayAt(base::span<const uint8_t> bytes,
+                            const FingerprintConfigImageString& array) {
+  // SAFETY: FromBytesVerified() checked that the array fits and is aligned.
+  return UNSAFE_BUFFERS(base::span(
+      reinterpret_cast<const T*>(bytes.data() + array.offset), array.length));
+}
+
+}  // namespace
+
+// static
+std::vector<uint8_t> FingerprintGpuProfileLibrary::Compile(
+    const std::vector<base::Value::Dict>& profiles,
+    std::vector<std::string>* errors) {
+  const size_t error_count = errors->size();
+  std::vector<std::string> names;
+  std::vector<std::vector<uint8_t>> images;
+  std::set<std::string> seen;
+  for (size_t i = 0; i < profiles.size(); ++i) {
+    const std::string* name = profiles[i].FindString("name");
+    if (!name || name->empty()) {
+      errors->push_back(base::StrCat(
+          {"profile ", base::NumberToString(i), ": missing \"name\""}));
+      continue;
+    }
+    if (!seen.insert(*name).second) {
+      errors->push_back(*name + ": duplicate profile name");
+      continue;
+    }
+    if (!profiles[i].FindString("vendor") ||
+        !profiles[i].FindString("renderer")) {
+      errors->push_back(*name +
+                        ": a profile needs \"vendor\" and \"renderer\"");
+      continue;
+    }
+    base::Value::Dict webgl = profiles[i].Clone();
+    webgl.Remove("name");
+    bool valid = true;
+    for (const auto [key, value] : webgl) {
+      if (!IsProfileKey(key)) {
+        errors->push_back(
+            base::StrCat({*name, ".", key, ": not part of a GPU profile"}));
+        valid = false;
+      }
+    }
+    base::Value::Dict root;
+    root.Set("webgl", std::move(webgl));
+    std::vector<std::string> profile_errors;
+    if (!FingerprintConfigImage::Validate(root, &profile_errors)) {
+      for (const std::string& error : profile_errors) {
+        errors->push_back(base::StrCat({*name, ": ", error}));
+      }
+      valid = false;
+    }
+    if (valid) {
+      names.push_back(*name);
+      images.push_back(FingerprintConfigImage::Compile(root));
+    }
+  }
+  if (errors->size() != error_count) {
+    return {};
+  }
+
+  // Keep the index at most half full so that probe sequences stay short.
+  size_t bucket_count = 2;
+  while (bucket_count < names.size() * 2) {
+    bucket_count *= 2;
+  }
+
+  // Lay out [header][entries][buckets][names and images].
+  const size_t entries_offset = sizeof(FingerprintGpuProfileLibrary);
+  const size_t buckets_offset =
+      entries_offset + names.size() * sizeof(FingerprintGpuProfileLibraryEntry);
+  size_t data_offset = base::bits::AlignUp<size_t>(
+      buckets_offset + bucket_count * sizeof(uint32_t), 8);
+
+  std::vector<FingerprintGpuProfileLibraryEntry> entries(names.size());
+  std::vector<uint32_t> buckets(bucket_count, 0);
+  for (size_t i = 0; i < names.size(); ++i) {
+    FingerprintGpuProfileLibraryEntry& entry = entries[i];
+    entry.name_hash = HashName(names[i]);
+    entry.name = {base::checked_cast<uint32_t>(data_offset),
+                  base::checked_cast<uint32_t>(names[i].size())};
+    data_offset =
+        base::bits::AlignUp<size_t>(data_offset + names[i].size(), 8);
+    entry.image = {base::checked_cast<uint32_t>(data_offset),
+                   base::checked_cast<uint32_t>(images[i].size())};
+    data_offset =
+        base::bits::AlignUp<size_t>(data_offset + images[i].size(), 8);
+
+    size_t bucket = entry.name_hash & (bucket_count - 1);
+    while (buckets[bucket]) {
+      bucket = (bucket + 1) & (bucket_count - 1);
+    }
+    buckets[bucket] = base::checked_cast<uint32_t>(i + 1);
+  }
+
+  FingerprintGpuProfileLibrary library = {};
+  library.magic = kMagic;
+  library.version = kVersion;
+  library.total_size = base::checked_cast<uint32_t>(data_offset);
+  library.entries = {base::checked_cast<uint32_t>(entries_offset),
+                     base::checked_cast<uint32_t>(entries.size())};
+  library.buckets = {base::checked_cast<uint32_t>(buckets_offset),
+                     base::checked_cast<uint32_t>(buckets.size())};
+
+  std::vector<uint8_t> bytes(library.total_size);
+  base::span<uint8_t> out(bytes);
+  out.first(sizeof(library)).copy_from(base::byte_span_from_ref(library));
+  out.subspan(entries_offset, buckets_offset - entries_offset)
+      .copy_from(base::as_byte_span(entries));
+  out.subspan(buckets_offset, bucket_count * sizeof(uint32_t))
+      .copy_from(base::as_byte_span(buckets));
+  for (size_t i = 0; i < names.size(); ++i) {
+    out.subspan(entries[i].name.offset, entries[i].name.length)
+        .copy_from(base::as_byte_span(names[i]));
+    out.subspan(entries[i].image.offset, entries[i].image.length)
+        .copy_from(images[i]);
+  }
+  const uint32_t checksum = ComputeChecksum(bytes);
+  out.subspan(offsetof(FingerprintGpuProfileLibrary, checksum),
+              sizeof(checksum))
+      .copy_from(base::byte_span_from_ref(checksum));
+  return bytes;
+}
+
+// static
+const FingerprintGpuProfileLibrary*
+FingerprintGpuProfileLibrary::FromBytesVerified(
+    base::span<const uint8_t> bytes) {
+  // Embedded images hold doubles, so the whole library must be 8-aligned;
+  // file mappings are page-aligned.
+  if (bytes.size() < sizeof(FingerprintGpuProfileLibrary) ||
+      reinterpret_cast<uintptr_t>(bytes.data()) % 8 != 0) {
+    return nullptr;
+  }
+  const auto* library =
+      reinterpret_cast<const FingerprintGpuProfileLibrary*>(bytes.data());
+  if (library->magic != kMagic || library->version != kVersion ||
+      library->total_size < sizeof(FingerprintGpuProfileLibrary) ||
+      library->total_size > bytes.size()) {
+    return nullptr;
+  }
+  bytes = bytes.first(library->total_size);
+  if (ComputeChecksum(bytes) != library->checksum) {
+    return nullptr;
+  }
+
+  auto fits = [&bytes](const FingerprintConfigImageString& array,
+                       size_t element_size, size_t alignment) {
+    const uint64_t end = static_cast<uint64_t>(array.offset) +
+                         static_cast<uint64_t>(array.length) * element_size;
+    return end <= bytes.size() && array.offset % alignment == 0;
+  };
+  const uint32_t bucket_count = library->buckets.length;
+  if (!fits(library->entries, sizeof(FingerprintGpuProfileLibraryEntry),
+            alignof(FingerprintGpuProfileLibraryEntry)) ||
+      !fits(library->buckets, sizeof(uint32_t), alignof(uint32_t)) ||
+      bucket_count <= library->entries.length ||
+      (bucket_count & (bucket_count - 1)) != 0) {
+    return nullptr;
+  }
+  // Every entry sits in exactly one bucket and the rest are empty, so Find()
+  // always reaches an empty bucket and never returns a duplicated entry.
+  std::vector<bool> seen(library->entries.length + 1);
+  for (uint32_t bucket : ArrayAt<uint32_t>(bytes, library->buckets)) {
+    if (bucket > library->entries.length || (bucket && seen[bucket])) {
+      return nullptr;
+    }
+    seen[bucket] = true;
+  }
+  for (uint32_t i = 1; i <= library->entries.length; ++i) {
+    if (!seen[i]) {
+      return nullptr;
+    }
+  }
+  for (const FingerprintGpuProfileLibraryEntry& entry :
+       ArrayAt<FingerprintGpuProfileLibraryEntry>(bytes, library->entries)) {
+    if (!fits(entry.name, 1, 1) || !fits(entry.image, 1, 8) ||
+        !FingerprintConfigImage::FromBytes(
+            bytes.subspan(entry.image.offset, entry.image.length))) {
+      return nullptr;
+    }
+  }
+  return library;
+}
+
+const FingerprintConfigImage* FingerprintGpuProfileLibrary::Find(
+    std::string_view name) const {
+  const base::span<const uint8_t> bytes = LibraryBytes(*this);
+  const auto entry_span =
+      ArrayAt<FingerprintGpuProfileLibraryEntry>(bytes, entries);
+  const auto bucket_span = ArrayAt<uint32_t>(bytes, buckets);
+  const uint32_t hash = HashName(name);
+  const size_t mask = bucket_span.size() - 1;
+  // FromBytesVerified() guarantees an empty bucket; the probe count is bounded
+  // anyway so a library that bypassed it cannot spin.
+  size_t bucket = hash & mask;
+  for (size_t probes = 0; probes < bucket_span.size();
+       ++probes, bucket = (bucket + 1) & mask) {
+    const uint32_t slot = bucket_span[bucket];
+    if (!slot) {
+      return nullptr;
+    }
+    const FingerprintGpuProfileLibraryEntry& entry = entry_span[slot - 1];
+    if (entry.name_hash == hash &&
+        base::as_string_view(bytes.subspan(entry.name.offset,
+                                           entry.name.length)) == name) {
+      return FingerprintConfigImage::FromBytes(
+          bytes.subspan(entry.image.offset, entry.image.length));
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace blink
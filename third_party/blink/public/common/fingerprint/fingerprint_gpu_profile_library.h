@@ -0,0 +1,87 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_GPU_PROFILE_LIBRARY_H_
+#define THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_GPU_PROFILE_LIBRARY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/values.h"
+#include "third_party/blink/public/common/common_export.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_config_image.h"
+
+namespace blink {
+
+// One profile of the library: its name and its compiled WebGL section.
+struct FingerprintGpuProfileLibraryEntry {
+  uint32_t name_hash;
+  uint32_t reserved;
+  FingerprintConfigImageString name;
+  // A complete FingerprintConfigImage holding only the profile's webgl
+  // section; its offsets are relative to its own start.
+  FingerprintConfigImageString image;
+};
+
+// Library of captured GPU profiles (vendor and renderer strings, static
+// limits, shader precisions, extension list), compiled offline by
+// fingerprint_config_compiler --gpu-profiles into gpu_profiles.fpgl next to
+// the executable. An identity selects one with "webgl": {"profile": "name"}.
+//
+// The browser maps the file once and resolves names through an open-addressed
+// hash index, so a lookup costs O(1) however many profiles the library holds.
+// FingerprintConfigImage::Compile() copies only the selected profile into the
+// identity's image, which is what renderers map; the library itself is never
+// copied per process.
+//
+// Layout: [FingerprintGpuProfileLibrary]
+//         [FingerprintGpuProfileLibraryEntry entries[profile_count]]
+//         [uint32_t buckets[bucket_count]][names and 8-byte aligned images]
+struct BLINK_COMMON_EXPORT FingerprintGpuProfileLibrary {
+  static constexpr uint32_t kMagic = 0x4C475046u;  // "FPGL"
+  static constexpr uint32_t kVersion = 1u;
+
+  // Checks every profile in |profiles| (one webgl section plus a unique
+  // "name" each) and compiles them into a library. Appends one message per
+  // problem to |errors| and returns an empty vector if there were any.
+  static std::vector<uint8_t> Compile(
+      const std::vector<base::Value::Dict>& profiles,
+      std::vector<std::string>* errors);
+
+  // Returns the library stored in |bytes| or nullptr if it is malformed or
+  // its checksum does not match. O(n); the browser calls it once per mapping.
+  static const FingerprintGpuProfileLibrary* FromBytesVerified(
+      base::span<const uint8_t> bytes);
+
+  // The compiled webgl section of profile |name|, or nullptr.
+  const FingerprintConfigImage* Find(std::string_view name) const;
+
+  size_t profile_count() const { return entries.length; }
+
+  // Header. |checksum| is base::PersistentHash() of the bytes from
+  // |entries| up to |total_size|.
+  uint32_t magic;
+  uint32_t version;
+  uint32_t total_size;
+  uint32_t checksum;
+  // |offset| points at an array of |length| FingerprintGpuProfileLibraryEntry.
+  FingerprintConfigImageString entries;
+  // |offset| points at an array of |length| (a power of two) uint32_t, each
+  // 0 for an empty bucket or an entry index plus one.
+  FingerprintConfigImageString buckets;
+};
+
+static_assert(std::is_trivially_copyable_v<FingerprintGpuProfileLibrary>);
+static_assert(sizeof(FingerprintGpuProfileLibrary) % 8 == 0);
+static_assert(sizeof(FingerprintGpuProfileLibraryEntry) % 8 == 0);
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_GPU_PROFILE_LIBRARY_H_
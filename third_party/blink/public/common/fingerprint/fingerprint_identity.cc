@@ -0,0 +1,55 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/public/common/fingerprint/fingerprint_identity.h"
+
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+
+namespace blink {
+
+namespace {
+
+base::FilePath GetExeDir() {
+  base::FilePath exe_dir;
+  if (!base::PathService::Get(base::DIR_EXE, &exe_dir)) {
+    return base::FilePath();
+  }
+  return exe_dir;
+}
+
+}  // namespace
+
+base::FilePath GetFingerprintIdentityDir() {
+  base::FilePath exe_dir = GetExeDir();
+  return exe_dir.empty() ? base::FilePath()
+                         : exe_dir.Append(kFingerprintIdentityDirName);
+}
+
+base::FilePath GetFingerprintGpuProfileLibraryPath() {
+  base::FilePath exe_dir = GetExeDir();
+  return exe_dir.empty() ? base::FilePath()
+                         : exe_dir.Append(kFingerprintGpuProfileLibraryName);
+}
+
+base::FilePath GetFingerprintIdentityPath(const base::FilePath& profile_path) {
+  base::FilePath exe_dir = GetExeDir();
+  if (exe_dir.empty()) {
+    return base::FilePath();
+  }
+  if (!profile_path.empty()) {
+    base::FilePath per_profile = exe_dir.Append(kFingerprintIdentityDirName)
+                                     .Append(profile_path.BaseName());
+    for (const base::FilePath::CharType* extension :
+         {kFingerprintImageExtension, FILE_PATH_LITERAL(".json")}) {
+      base::FilePath candidate = per_profile.AddExtension(extension);
+      if (base::PathExists(candidate)) {
+        return candidate;
+      }
+    }
+  }
+  return exe_dir.Append(kFingerprintConfigFileName);
+}
+
+}  // namespace blink
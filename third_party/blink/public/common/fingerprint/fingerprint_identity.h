@@ -0,0 +1,50 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_IDENTITY_H_
+#define THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_IDENTITY_H_
+
+#include "base/files/file_path.h"
+#include "third_party/blink/public/common/common_export.h"
+
+namespace blink {
+
+// Browser-wide identity file, next to the executable.
+inline constexpr base::FilePath::CharType kFingerprintConfigFileName[] =
+    FILE_PATH_LITERAL("fingerprint.json");
+
+// Directory next to the executable holding one identity file per profile,
+// named after the profile directory (e.g. "fingerprints/Profile 1.json").
+inline constexpr base::FilePath::CharType kFingerprintIdentityDirName[] =
+    FILE_PATH_LITERAL("fingerprints");
+
+// Extension of identities compiled offline by fingerprint_config_compiler
+// (e.g. "fingerprints/Profile 1.fpci"). Preferred over the .json file.
+inline constexpr base::FilePath::CharType kFingerprintImageExtension[] =
+    FILE_PATH_LITERAL(".fpci");
+
+// Library of captured GPU profiles that identities select with
+// "webgl": {"profile": "name"}, next to the executable. Compiled by
+// fingerprint_config_compiler --gpu-profiles.
+inline constexpr base::FilePath::CharType kFingerprintGpuProfileLibraryName[] =
+    FILE_PATH_LITERAL("gpu_profiles.fpgl");
+
+// Returns the directory holding per-profile identity files, or an empty path
+// if the executable directory is unknown.
+BLINK_COMMON_EXPORT base::FilePath GetFingerprintIdentityDir();
+
+// Returns the path of the GPU profile library, or an empty path if the
+// executable directory is unknown. The file need not exist.
+BLINK_COMMON_EXPORT base::FilePath GetFingerprintGpuProfileLibraryPath();
+
+// Returns the identity file for the profile stored at |profile_path|: its
+// precompiled or JSON per-profile file when present, otherwise the
+// browser-wide fingerprint.json.
+// Blocks on a file existence check.
+BLINK_COMMON_EXPORT base::FilePath GetFingerprintIdentityPath(
+    const base::FilePath& profile_path);
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_PUBLIC_COMMON_FINGERPRINT_FINGERPRINT_IDENTITY_H_
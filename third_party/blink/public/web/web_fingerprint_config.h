@@ -0,0 +1,27 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_PUBLIC_WEB_WEB_FINGERPRINT_CONFIG_H_
+#define THIRD_PARTY_BLINK_PUBLIC_WEB_WEB_FINGERPRINT_CONFIG_H_
+
+#include <stdint.h>
+
+#include "base/containers/span.h"
+#include "third_party/blink/public/platform/web_common.h"
+
+namespace blink {
+
+// Replaces this process's fingerprint identity with the compiled
+// FingerprintConfigImage in |image_bytes|. The bytes are copied, so they only
+// have to outlive the call. Returns false if the image is invalid.
+BLINK_EXPORT bool PublishFingerprintConfigImage(
+    base::span<const uint8_t> image_bytes);
+
+// Applies the fingerprint timezone to libc, ICU and V8 for the whole process.
+// Must be called once at renderer startup, before V8 is initialized.
+BLINK_EXPORT void ApplyFingerprintTimezoneAtStartup();
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_PUBLIC_WEB_WEB_FINGERPRINT_CONFIG_H_
@@ -166,6 +166,7 @@
 #include "third_party/blink/renderer/core/execution_context/security_context.h"
 #include "third_party/blink/renderer/core/frame/csp/content_security_policy.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
@@ -297,24 +298,10 @@
 #include "ui/accessibility/ax_mode.h"
 #include "ui/gfx/geometry/rect_conversions.h"
 
-// [修复] ClientRects 确定性噪声函数
-// 参数 value: rect 的属性值 (x/y/width/height)
-// 返回值: 基于 global_seed 和 value 的确定性噪声
+// [修复] ClientRects 确定性噪声（基于 global_seed 的计数器式 PRNG）
 double getDeterministicRectsNoise(double value) {
-  double factor =
-      blink::FingerprintConfig::Instance().GetClientRectsNoiseFactor();
-  int seed = blink::FingerprintConfig::Instance().GetGlobalSeed();
-
-  // 将 value 乘以 10000 转为整数，保留亚像素精度
-  // 与 seed XOR 混合实现确定性
-  unsigned value_int =
-      static_cast<unsigned>(static_cast<int>(value * 10000.0) & 0x7FFFFFFFu);
-  unsigned combined = (value_int ^ static_cast<unsigned>(seed)) * 2654435761u;
-
-  // 生成 -1.0 到 +1.0 范围的确定性比率
-  int rand_int = static_cast<int>(combined % 100u);
-  double ratio = (rand_int - 50) / 50.0;
-  return ratio * factor;
+  return blink::FingerprintConfig::RectsNoise(
+      value, blink::FingerprintConfig::Instance().GetClientRectsNoiseFactor());
 }
 
 namespace blink {
@@ -3444,6 +3431,9 @@ DOMRectList* Element::getClientRects() {
   }
   LayoutObject* element_layout_object = GetLayoutObject();
   DCHECK(element_layout_object);
+  FINGERPRINT_TRACE_HOOK(
+      "GetClientRects",
+      FingerprintConfig::Instance().GetClientRectsNoiseFactor() != 0);
   for (auto& rect : rects) {
     GetDocument().AdjustRectForScrollAndAbsoluteZoom(rect,
                                                      *element_layout_object);
@@ -3514,6 +3504,9 @@ DOMRect* Element::GetBoundingClientRect() {
   DOMRect* rect = DOMRect::FromRectF(GetBoundingClientRectNoLifecycleUpdate());
 
   // [修复] 每个属性使用各自的确定性噪声
+  FINGERPRINT_TRACE_HOOK(
+      "GetBoundingClientRect",
+      FingerprintConfig::Instance().GetClientRectsNoiseFactor() != 0);
   if (rect) {
     rect->setX(rect->x() + getDeterministicRectsNoise(rect->x()));
     rect->setY(rect->y() + getDeterministicRectsNoise(rect->y()));
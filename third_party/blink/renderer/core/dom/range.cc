@@ -1739,7 +1739,7 @@ DOMRectList* Range::getClientRects() const {
       noise_factor = 0.000004;
     }
 
-    // [修改] 使用统一的 GenerateNoise 函数
+    // [修改] 使用统一的 RectsNoise 函数（与 Element 共用同一噪声流）
     // 遍历所有 rect 进行处理
     for (unsigned i = 0; i < rect_list->length(); ++i) {
       DOMRect* rect = rect_list->item(i);
@@ -1750,13 +1750,13 @@ DOMRectList* Range::getClientRects() const {
       // 传入 rect->x() 作为 input，保证对同一个 x 值生成的噪声永远一样
       // 传入 noise_factor 控制幅度
       rect->setX(rect->x() +
-                 FingerprintConfig::GenerateNoise(rect->x(), noise_factor));
+                 FingerprintConfig::RectsNoise(rect->x(), noise_factor));
       rect->setY(rect->y() +
-                 FingerprintConfig::GenerateNoise(rect->y(), noise_factor));
-      rect->setWidth(rect->width() + FingerprintConfig::GenerateNoise(
-                                         rect->width(), noise_factor));
-      rect->setHeight(rect->height() + FingerprintConfig::GenerateNoise(
-                                           rect->height(), noise_factor));
+                 FingerprintConfig::RectsNoise(rect->y(), noise_factor));
+      rect->setWidth(rect->width() + FingerprintConfig::RectsNoise(
+                                       rect->width(), noise_factor));
+      rect->setHeight(rect->height() + FingerprintConfig::RectsNoise(
+                                         rect->height(), noise_factor));
     }
   }
   // ================= [FINGERPRINT MOD END] =================
@@ -1782,17 +1782,17 @@ DOMRect* Range::getBoundingClientRect() const {
       noise_factor = 0.000004;
     }
 
-    // [修改] 使用统一的 GenerateNoise 函数
+    // [修改] 使用统一的 RectsNoise 函数（与 Element 共用同一噪声流）
     // 传入 rect->x() 作为 input，保证对同一个 x 值生成的噪声永远一样
     // 传入 noise_factor 控制幅度
     rect->setX(rect->x() +
-               FingerprintConfig::GenerateNoise(rect->x(), noise_factor));
+               FingerprintConfig::RectsNoise(rect->x(), noise_factor));
     rect->setY(rect->y() +
-               FingerprintConfig::GenerateNoise(rect->y(), noise_factor));
-    rect->setWidth(rect->width() + FingerprintConfig::GenerateNoise(
-                                       rect->width(), noise_factor));
-    rect->setHeight(rect->height() + FingerprintConfig::GenerateNoise(
-                                         rect->height(), noise_factor));
+               FingerprintConfig::RectsNoise(rect->y(), noise_factor));
+    rect->setWidth(rect->width() + FingerprintConfig::RectsNoise(
+                                     rect->width(), noise_factor));
+    rect->setHeight(rect->height() + FingerprintConfig::RectsNoise(
+                                       rect->height(), noise_factor));
   }
   // ================= [FINGERPRINT MOD END] =================
 
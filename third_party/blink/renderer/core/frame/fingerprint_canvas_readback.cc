@@ -0,0 +1,163 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/frame/fingerprint_canvas_readback.h"
+
+#include <utility>
+
+#include "base/compiler_specific.h"
+#include "base/containers/span.h"
+#include "base/rand_util.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise_tile.h"
+#include "third_party/blink/renderer/core/imagebitmap/image_bitmap.h"
+#include "third_party/blink/renderer/platform/graphics/static_bitmap_image.h"
+#include "third_party/blink/renderer/platform/graphics/unaccelerated_static_bitmap_image.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace blink {
+
+namespace {
+
+bool IsNoisableColorType(SkColorType color_type) {
+  return color_type == kRGBA_8888_SkColorType ||
+         color_type == kBGRA_8888_SkColorType;
+}
+
+// Allocates |pixels| as the unpremultiplied RGBA destination for a readback
+// of an image described by |source_info|. Returns false for images that are
+// not 8-bit.
+bool AllocateReadbackPixels(const SkImageInfo& source_info, SkBitmap& pixels) {
+  return IsNoisableColorType(source_info.colorType()) &&
+         pixels.tryAllocPixels(source_info.makeColorType(kRGBA_8888_SkColorType)
+                                   .makeAlphaType(kUnpremul_SkAlphaType));
+}
+
+}  // namespace
+
+FingerprintCanvasReadback::FingerprintCanvasReadback(Mode mode)
+    : FingerprintCanvasReadback(mode, FingerprintConfig::Instance()) {}
+
+FingerprintCanvasReadback::FingerprintCanvasReadback(
+    Mode mode,
+    const FingerprintConfig& identity)
+    : spoofed_(identity.GetCanvasMeasureTextNoiseEnable()),
+      active_(spoofed_ || mode == Mode::kExport),
+      seed_(spoofed_ ? identity.GetGlobalSeed() : 0) {
+  if (!active_) {
+    return;
+  }
+  if (mode == Mode::kExport && !spoofed_) {
+    seed_ = static_cast<int32_t>(base::RandUint64());
+  }
+  // Random export keys are used once; only the identity's tile is shared.
+  tile_ = spoofed_ ? FingerprintNoiseTile::Get(
+                         seed_, FingerprintNoiseDomain::kCanvasPixels)
+                   : FingerprintNoiseTile::Create(
+                         seed_, FingerprintNoiseDomain::kCanvasPixels);
+}
+
+FingerprintCanvasReadback::FingerprintCanvasReadback(
+    const FingerprintCanvasReadback&) = default;
+FingerprintCanvasReadback& FingerprintCanvasReadback::operator=(
+    const FingerprintCanvasReadback&) = default;
+FingerprintCanvasReadback::~FingerprintCanvasReadback() = default;
+
+bool FingerprintCanvasReadback::ApplyToPixmap(const SkPixmap& pixmap,
+                                              int origin_x,
+                                              int origin_y) const {
+  if (!active_ || !pixmap.writable_addr() ||
+      !IsNoisableColorType(pixmap.colorType()) ||
+      pixmap.alphaType() == kPremul_SkAlphaType) {
+    return false;
+  }
+  // SAFETY: the pixmap covers computeByteSize() bytes from writable_addr().
+  auto pixels =
+      UNSAFE_BUFFERS(base::span(static_cast<uint8_t*>(pixmap.writable_addr()),
+                                pixmap.computeByteSize()));
+  tile_->ApplyToPixels(pixels, pixmap.rowBytes(), pixmap.width(),
+                       pixmap.height(), origin_x, origin_y);
+  return true;
+}
+
+bool FingerprintCanvasReadback::ReadbackRaster(const SkImage& image,
+                                               SkBitmap& pixels,
+                                               int origin_x,
+                                               int origin_y) const {
+  if (!active_ || !AllocateReadbackPixels(image.imageInfo(), pixels) ||
+      !image.readPixels(pixels.info(), pixels.getPixels(), pixels.rowBytes(),
+                        0, 0)) {
+    return false;
+  }
+  return ApplyToPixmap(pixels.pixmap(), origin_x, origin_y);
+}
+
+bool FingerprintCanvasReadback::Readback(StaticBitmapImage& image,
+                                         SkBitmap& pixels,
+                                         int origin_x,
+                                         int origin_y) const {
+  if (!active_) {
+    return false;
+  }
+  // Straight from the snapshot into |pixels|, as getImageData() does, so a
+  // texture-backed canvas costs one GPU readback and no intermediate copy.
+  const PaintImage paint_image = image.PaintImageForCurrentFrame();
+  if (!AllocateReadbackPixels(paint_image.GetSkImageInfo(), pixels) ||
+      !paint_image.readPixels(pixels.info(), pixels.getPixels(),
+                              pixels.rowBytes(), 0, 0)) {
+    return false;
+  }
+  return ApplyToPixmap(pixels.pixmap(), origin_x, origin_y);
+}
+
+sk_sp<SkImage> FingerprintCanvasReadback::ApplyToImage(sk_sp<SkImage> image,
+                                                       int origin_x,
+                                                       int origin_y) const {
+  SkBitmap pixels;
+  if (!image || image->isTextureBacked() ||
+      !ReadbackRaster(*image, pixels, origin_x, origin_y)) {
+    return image;
+  }
+  pixels.setImmutable();
+  return SkImages::RasterFromBitmap(pixels);
+}
+
+scoped_refptr<StaticBitmapImage> FingerprintCanvasReadback::ApplyToImage(
+    scoped_refptr<StaticBitmapImage> image,
+    int origin_x,
+    int origin_y) const {
+  SkBitmap pixels;
+  if (!image || !Readback(*image, pixels, origin_x, origin_y)) {
+    return image;
+  }
+  pixels.setImmutable();
+  scoped_refptr<StaticBitmapImage> noised =
+      UnacceleratedStaticBitmapImage::Create(SkImages::RasterFromBitmap(pixels),
+                                             image->Orientation());
+  if (!noised) {
+    return image;
+  }
+  noised->SetOriginClean(image->OriginClean());
+  return noised;
+}
+
+ImageBitmap* FingerprintCanvasReadback::ApplyToImageBitmap(
+    ImageBitmap* bitmap,
+    const std::optional<gfx::Rect>& crop_rect) const {
+  if (!active_ || !bitmap || !bitmap->BitmapImage()) {
+    return bitmap;
+  }
+  const gfx::Point origin = crop_rect ? crop_rect->origin() : gfx::Point();
+  scoped_refptr<StaticBitmapImage> image = bitmap->BitmapImage();
+  scoped_refptr<StaticBitmapImage> noised =
+      ApplyToImage(image, origin.x(), origin.y());
+  if (noised == image) {
+    return bitmap;
+  }
+  return MakeGarbageCollected<ImageBitmap>(std::move(noised));
+}
+
+}  // namespace blink
@@ -0,0 +1,109 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_CANVAS_READBACK_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_CANVAS_READBACK_H_
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "base/memory/scoped_refptr.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "ui/gfx/geometry/rect.h"
+
+class SkBitmap;
+class SkImage;
+class SkPixmap;
+
+namespace blink {
+
+class FingerprintNoiseTile;
+class ImageBitmap;
+class StaticBitmapImage;
+
+// Canvas readback noise, shared by every path that lets a page see canvas
+// pixels: getImageData(), toDataURL(), toBlob(), OffscreenCanvas
+// convertToBlob() and createImageBitmap() of either canvas type.
+//
+// The identity is read once, from the snapshot current when the object is
+// created; after that the object is a plain value that
+// touches no global or thread-bound state, so it works the same on the main
+// thread, in dedicated and shared workers and on the worker pool, and keeps
+// using the identity it started with if a new config is published
+// mid-export. All pixels get the identity's kCanvasPixels
+// FingerprintNoiseTile, indexed by canvas coordinates, so every path produces
+// the same noised pixels for the same canvas content, and a readback costs
+// one pass over the output with no per-pixel hashing.
+class CORE_EXPORT FingerprintCanvasReadback {
+  DISALLOW_NEW();
+
+ public:
+  enum class Mode {
+    // Pixels handed to the page as-is (getImageData(), ImageBitmap): noised
+    // only while the identity enables canvas noise.
+    kReadback,
+    // Encoded exports: with canvas noise off each export still gets a fresh
+    // random key, as toDataURL() always did.
+    kExport,
+  };
+
+  explicit FingerprintCanvasReadback(Mode mode);
+  FingerprintCanvasReadback(Mode mode, const FingerprintConfig& identity);
+  FingerprintCanvasReadback(const FingerprintCanvasReadback&);
+  FingerprintCanvasReadback& operator=(const FingerprintCanvasReadback&);
+  ~FingerprintCanvasReadback();
+
+  // Whether the identity enables canvas noise; what the trace hooks record.
+  bool spoofed() const { return spoofed_; }
+  // Whether the methods below change pixels at all.
+  bool active() const { return active_; }
+
+  // Noises unpremultiplied or opaque 8-bit RGBA/BGRA pixels in place. Returns
+  // false, leaving them untouched, for other formats.
+  bool ApplyToPixmap(const SkPixmap& pixmap, int origin_x, int origin_y) const;
+
+  // Reads |image| into |pixels| as unpremultiplied RGBA and noises it: the
+  // only readback of an export. Returns false if inactive or if |image| is
+  // not an 8-bit image, in which case the caller encodes |image| unchanged.
+  bool Readback(StaticBitmapImage& image,
+                SkBitmap& pixels,
+                int origin_x = 0,
+                int origin_y = 0) const;
+
+  // Noised, unpremultiplied RGBA raster copies; staying unpremultiplied keeps
+  // the noise intact for translucent pixels. The input is returned unchanged
+  // when there is nothing to do.
+  sk_sp<SkImage> ApplyToImage(sk_sp<SkImage> image,
+                              int origin_x = 0,
+                              int origin_y = 0) const;
+  scoped_refptr<StaticBitmapImage> ApplyToImage(
+      scoped_refptr<StaticBitmapImage> image,
+      int origin_x,
+      int origin_y) const;
+  // For createImageBitmap(canvas): |crop_rect| gives the canvas coordinates
+  // of the bitmap's top-left pixel.
+  ImageBitmap* ApplyToImageBitmap(ImageBitmap* bitmap,
+                                  const std::optional<gfx::Rect>& crop_rect)
+      const;
+
+ private:
+  bool ReadbackRaster(const SkImage& image,
+                      SkBitmap& pixels,
+                      int origin_x,
+                      int origin_y) const;
+
+  bool spoofed_;
+  bool active_;
+  int32_t seed_;
+  // Set iff |active_|.
+  scoped_refptr<const FingerprintNoiseTile> tile_;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_CANVAS_READBACK_H_
@@ -1,22 +1,36 @@
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "base/base64.h"
 #include "base/command_line.h"
+#include "base/compiler_specific.h"
+#include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
 #include "base/path_service.h"
+#include "base/synchronization/lock.h"
 #include "base/values.h"
+#include "build/build_config.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_config_image.h"
+#include "third_party/blink/public/web/web_fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_timezone.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_utf8_adaptor.h"
 
-// ICU 引用
-#include <unicode/timezone.h>
-#include <unicode/unistr.h>
-#include <unicode/utypes.h>  // [修复] 引入 UErrorCode
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
+#include "base/file_descriptor_store.h"
+#endif
 
 namespace blink {
 
@@ -35,7 +49,8 @@ const char* kDefaultConfigJson = R"JSON({
     "renderer": "ANGLE (NVIDIA, NVIDIA GeForce RTX 4090 Direct3D11, vs_5_0, ps_5_0)",
     "clear_color_noise": 0.005,
     "viewport_noise_max": 15,
-    "read_pixels_noise_max": 3
+    "read_pixels_noise_max": 3,
+    "render_exact": false
   },
   "hardware": {
     "concurrency": 16,
@@ -83,6 +98,27 @@ const char* kDefaultConfigJson = R"JSON({
   }
 })JSON";
 
+// =========================================================
+// 快照发布 (RCU)
+// =========================================================
+
+namespace {
+
+std::atomic<const FingerprintConfig*> g_current_config{nullptr};
+
+base::Lock& PublishLock() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(base::Lock, lock, ());
+  return lock;
+}
+
+Vector<std::unique_ptr<FingerprintConfig>>& PublishedSnapshots() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(Vector<std::unique_ptr<FingerprintConfig>>,
+                                  snapshots, ());
+  return snapshots;
+}
+
+}  // namespace
+
 // =========================================================
 // 静态方法
 // =========================================================
@@ -95,16 +131,71 @@ bool FingerprintConfig::IsFontNoiseEnabled() {
   return Instance().fonts_offset_noise_prob_percent_ > 0;
 }
 
-FingerprintConfig* FingerprintConfig::GetInstance() {
+const FingerprintConfig* FingerprintConfig::GetInstance() {
   return &Instance();
 }
 
-FingerprintConfig& FingerprintConfig::Instance() {
-  DEFINE_STATIC_LOCAL(FingerprintConfig, instance, ());
-  if (!instance.is_loaded_) {
-    instance.LoadConfig();
+const FingerprintConfig& FingerprintConfig::Instance() {
+  const FingerprintConfig* current =
+      g_current_config.load(std::memory_order_acquire);
+  if (current) [[likely]] {
+    return *current;
+  }
+  return InitializeCurrent();
+}
+
+// static
+const FingerprintConfig& FingerprintConfig::InitializeCurrent() {
+  base::AutoLock locker(PublishLock());
+  // Another thread may have won the race while we waited for the lock.
+  if (const FingerprintConfig* current =
+          g_current_config.load(std::memory_order_acquire)) {
+    return *current;
+  }
+  std::unique_ptr<FingerprintConfig> initial = LoadConfig();
+  const FingerprintConfig& result = *initial;
+  PublishLocked(std::move(initial));
+  // 进程级时区只在这里应用一次，之后创建的 frame/worker 不再触碰时区
+  FingerprintTimezone::Apply(result);
+  return result;
+}
+
+// static
+bool FingerprintConfig::Publish(base::span<const uint8_t> image_bytes) {
+  const FingerprintConfigImage* image =
+      FingerprintConfigImage::FromBytes(image_bytes);
+  if (!image) {
+    return false;
+  }
+  auto snapshot = base::WrapUnique(new FingerprintConfig());
+  snapshot->ApplyImage(*image);
+
+  // Make sure the initial snapshot (and its zone) is in place first.
+  Instance();
+  const FingerprintConfig& published = *snapshot;
+  {
+    base::AutoLock locker(PublishLock());
+    PublishLocked(std::move(snapshot));
   }
-  return instance;
+  // No-op unless the zone differs from the one already applied.
+  FingerprintTimezone::Apply(published);
+  return true;
+}
+
+// static
+void FingerprintConfig::PublishLocked(
+    std::unique_ptr<FingerprintConfig> snapshot) {
+  PublishLock().AssertAcquired();
+  g_current_config.store(snapshot.get(), std::memory_order_release);
+  // Readers hold plain references obtained from Instance() without a grace
+  // period, so superseded snapshots are kept for the process lifetime. The
+  // browser only pushes changed images (FingerprintConfigService::SetImage()),
+  // so this holds one snapshot per distinct identity the process was given.
+  PublishedSnapshots().push_back(std::move(snapshot));
+}
+
+bool PublishFingerprintConfigImage(base::span<const uint8_t> image_bytes) {
+  return FingerprintConfig::Publish(image_bytes);
 }
 
 FingerprintConfig::FingerprintConfig() = default;
@@ -128,6 +219,29 @@ int FingerprintConfig::GetWebGLViewportNoiseMax() const {
 int FingerprintConfig::GetWebGLReadPixelsNoiseMax() const {
   return webgl_read_pixels_noise_max_;
 }
+bool FingerprintConfig::GetWebGLRenderExact() const {
+  return webgl_render_exact_;
+}
+const FingerprintConfig::WebGLParameter* FingerprintConfig::GetWebGLParameter(
+    uint32_t pname) const {
+  auto it = webgl_parameters_.find(pname);
+  return it == webgl_parameters_.end() ? nullptr : &it->value;
+}
+const FingerprintConfig::WebGLShaderPrecision*
+FingerprintConfig::GetWebGLShaderPrecision(uint32_t shader_type,
+                                           uint32_t precision_type) const {
+  if (shader_type > 0xFFFF || !precision_type || precision_type > 0xFFFF) {
+    return nullptr;
+  }
+  auto it = webgl_shader_precisions_.find((shader_type << 16) | precision_type);
+  return it == webgl_shader_precisions_.end() ? nullptr : &it->value;
+}
+const Vector<String>* FingerprintConfig::GetWebGLExtensions() const {
+  return webgl_extensions_ ? &*webgl_extensions_ : nullptr;
+}
+std::optional<bool> FingerprintConfig::GetWebGLAntialias() const {
+  return webgl_antialias_;
+}
 int FingerprintConfig::GetCanvasFillTextOffsetMax() const {
   return canvas_fill_text_offset_max_;
 }
@@ -168,339 +282,213 @@ int FingerprintConfig::GetGlobalSeed() const {
 // 核心配置加载
 // =========================================================
 
-void FingerprintConfig::LoadConfig() {
-  std::string config_content;
-  bool is_config_loaded = false;
-
-  // 1. 优先尝试：从命令行参数获取 (IPC 方式，支持沙箱)
-  const base::CommandLine* command_line =
-      base::CommandLine::ForCurrentProcess();
-  if (command_line->HasSwitch("fingerprint-config")) {
-    std::string encoded_config =
-        command_line->GetSwitchValueASCII("fingerprint-config");
-    if (base::Base64Decode(encoded_config, &config_content)) {
-      is_config_loaded = true;
-      fprintf(stderr,
-              "[FINGERPRINT] Config loaded via CommandLine (Sandbox Safe).\n");
-    } else {
-      fprintf(stderr,
-              "[FINGERPRINT] ERROR: Failed to decode command line config.\n");
+void FingerprintConfig::ApplyImage(const FingerprintConfigImage& image) {
+  using Flag = FingerprintConfigImage::Flag;
+  auto str = [&image](const FingerprintConfigImageString& ref) {
+    return String::FromUTF8(image.GetString(ref));
+  };
+
+  global_seed_ = image.global_seed;
+
+  // [UA]
+  ua.enabled = image.HasFlag(Flag::kUAEnabled);
+  ua.mobile = image.HasFlag(Flag::kUAMobile);
+  ua.ua_string = str(image.ua_string);
+  ua.platform = str(image.ua_platform);
+  ua.platform_version = str(image.ua_platform_version);
+  ua.language = str(image.ua_language);
+
+  // [WebGL]
+  webgl_vendor_ = str(image.webgl_vendor);
+  webgl_renderer_ = str(image.webgl_renderer);
+  webgl_clear_color_noise_ = image.webgl_clear_color_noise;
+  webgl_viewport_noise_max_ = image.webgl_viewport_noise_max;
+  webgl_read_pixels_noise_max_ = image.webgl_read_pixels_noise_max;
+  webgl_render_exact_ =
+      image.HasFlag(FingerprintConfigImage::kWebGLRenderExact);
+  // GPU profile: copied into hash tables once so that getParameter() and
+  // friends are a single lookup.
+  webgl_parameters_.clear();
+  for (const auto& parameter : image.GetWebGLParameters()) {
+    WebGLParameter& entry =
+        webgl_parameters_.insert(parameter.pname, WebGLParameter())
+            .stored_value->value;
+    entry.count = std::min<wtf_size_t>(parameter.count, entry.values.size());
+    for (wtf_size_t i = 0; i < entry.count; ++i) {
+      entry.values[i] = UNSAFE_BUFFERS(parameter.values[i]);
     }
   }
-
-  // 2. 备用尝试：直接读取文件 (仅在 --no-sandbox 模式或特定环境下有效)
-  if (!is_config_loaded) {
-    base::FilePath exe_path;
-    if (base::PathService::Get(base::DIR_EXE, &exe_path)) {
-      base::FilePath config_path = exe_path.AppendASCII("fingerprint.json");
-      if (base::ReadFileToString(config_path, &config_content)) {
-        is_config_loaded = true;
+  webgl_shader_precisions_.clear();
+  for (uint32_t shader_type : {0x8B31u /* VERTEX_SHADER */,
+                               0x8B30u /* FRAGMENT_SHADER */}) {
+    for (uint32_t precision_type = 0x8DF0u /* LOW_FLOAT */;
+         precision_type <= 0x8DF5u /* HIGH_INT */; ++precision_type) {
+      if (const auto* precision =
+              image.GetShaderPrecision(shader_type, precision_type)) {
+        webgl_shader_precisions_.Set(
+            (shader_type << 16) | precision_type,
+            WebGLShaderPrecision{precision->range_min, precision->range_max,
+                                 precision->precision});
       }
     }
   }
-
-  // 3. [Fix] If no config loaded, use internal default
-  if (!is_config_loaded) {
-    config_content = kDefaultConfigJson;
-    is_config_loaded = true;
-    fprintf(stderr, "[FINGERPRINT] using built-in default config.\n");
+  webgl_extensions_.reset();
+  if (image.HasFlag(Flag::kWebGLExtensions)) {
+    webgl_extensions_.emplace();
+    for (size_t i = 0; i < image.webgl_extension_count(); ++i) {
+      webgl_extensions_->push_back(String::FromUTF8(image.GetWebGLExtension(i)));
+    }
+  }
+  webgl_antialias_.reset();
+  if (image.HasFlag(Flag::kWebGLAntialiasSet)) {
+    webgl_antialias_ = image.HasFlag(Flag::kWebGLAntialias);
   }
 
-  // 4. Parse JSON and apply config
-  if (is_config_loaded) {
-    auto result =
-        base::JSONReader::ReadAndReturnValueWithError(config_content, 0);
-    if (result.has_value() && result->is_dict()) {
-      const auto& root = result->GetDict();
-      global_seed_ = root.FindInt("global_seed").value_or(0);
-
-      // [UA]
-      const auto* ua_node = root.FindDict("ua_config");
-      if (ua_node) {
-        ua.enabled = ua_node->FindBool("enabled").value_or(false);
-        const std::string* s = ua_node->FindString("ua_string");
-        if (s) {
-          ua.ua_string = String::FromUTF8(s->c_str());
-        }
-        s = ua_node->FindString("platform");
-        if (s) {
-          ua.platform = String::FromUTF8(s->c_str());
-        }
-        // [Added] Language parsing
-        s = ua_node->FindString("language");
-        if (s) {
-          ua.language = String::FromUTF8(s->c_str());
-        }
-      }
-
-      // [WebGL]
-      const auto* webgl = root.FindDict("webgl");
-      if (webgl) {
-        const std::string* s = webgl->FindString("vendor");
-        if (s) {
-          webgl_vendor_ = String::FromUTF8(s->c_str());
-        }
-        s = webgl->FindString("renderer");
-        if (s) {
-          webgl_renderer_ = String::FromUTF8(s->c_str());
-        }
-
-        webgl_clear_color_noise_ =
-            webgl->FindDouble("clear_color_noise").value_or(0.005);
-        webgl_viewport_noise_max_ =
-            webgl->FindInt("viewport_noise_max").value_or(15);
-        webgl_read_pixels_noise_max_ =
-            webgl->FindInt("read_pixels_noise_max").value_or(3);
-      }
-
-      // [Hardware]
-      const auto* hw = root.FindDict("hardware");
-      if (hw) {
-        // 1. CPU 核心数处理：强制转换为偶数
-        // 理由：现代 CPU 逻辑核心数几乎均为偶数，出现奇数会触发风险标记
-        int cpu_val = hw->FindInt("concurrency").value_or(16);
-        if (cpu_val > 0 && cpu_val % 2 != 0) {
-          cpu_val += 1;  // 奇数向上取偶，例如 7 变为 8
-        }
-        hardware_concurrency_ = cpu_val;
-
-        // 2. 内存容量处理：自动向下取最接近的 2 的幂次方
-        // 理由：Web 暴露的 deviceMemory 通常为 0.25, 0.5, 1, 2, 4, 8 等标准值
-        // 该逻辑确保即使 JSON 填入 7 或 12，也会返回 4 或 8 这种真实数值
-        double mem_val = hw->FindDouble("memory_gb").value_or(32.0);
-        if (mem_val > 0) {
-          // 使用数学公式：2^(floor(log2(mem_val)))
-          mem_val = std::pow(2, std::floor(std::log2(mem_val)));
-        }
-        device_memory_ = static_cast<float>(mem_val);
-      }
-
-      // [Screen]
-      const auto* scr = root.FindDict("screen");
-      if (scr) {
-        screen.enabled = scr->FindBool("enable_spoofing").value_or(false);
-        screen.width = scr->FindInt("width").value_or(1920);
-        screen.height = scr->FindInt("height").value_or(1080);
-        screen.color_depth = scr->FindInt("color_depth").value_or(24);
-      }
-
-      // [Canvas & Fonts]
-      const auto* cvs = root.FindDict("canvas");
-      if (cvs) {
-        canvas_measure_text_noise_enable_ =
-            cvs->FindBool("measure_text_noise_enable").value_or(true);
-        canvas_fill_text_offset_max_ =
-            cvs->FindInt("fill_text_offset_max").value_or(3);
-      }
-
-      // [Audio]
-      const auto* aud = root.FindDict("audio");
-      if (aud) {
-        audio_sample_rate_offset_max_ =
-            aud->FindInt("sample_rate_offset_max").value_or(100);
-
-        // [Added] Populate public AudioConfig struct
-        audio.spoofing_enabled =
-            aud->FindBool("spoofing_enabled").value_or(false);
-        audio.sample_rate_offset =
-            aud->FindDouble("sample_rate_offset").value_or(0.0);
-        audio.reduction_noise_factor =
-            aud->FindDouble("reduction_noise_factor").value_or(0.001);
-      }
-
-      // [Plugins]
-      const auto* plg = root.FindDict("plugins");
-      if (plg) {
-        plugins_description_noise_max_ =
-            plg->FindInt("description_noise_max").value_or(5);
-      }
-
-      // [解析 Rects]
-      const auto* rects = root.FindDict("rects");
-      if (rects) {
-        client_rects_noise_factor_ =
-            rects->FindDouble("noise_factor").value_or(0.000005);
-      }
-
-      // [Fonts]
-      const auto* fonts = root.FindDict("fonts");
-      if (fonts) {
-        fonts_offset_noise_prob_percent_ =
-            fonts->FindInt("offset_noise_prob_percent").value_or(10);
-
-        // [新增] 解析 JSON 中的 whitelist 数组
-        const auto* whitelist_node = fonts->FindList("whitelist");
-        if (whitelist_node) {
-          font_whitelist_.clear();
-          for (const auto& value : *whitelist_node) {
-            if (value.is_string()) {
-              font_whitelist_.push_back(
-                  String::FromUTF8(value.GetString().c_str()));
-            }
-          }
-        }
-      }
-
-      // [Network]
-      const auto* net = root.FindDict("network");
-      if (net) {
-        network.spoofing_enabled =
-            net->FindBool("spoofing_enabled").value_or(true);
-        network.downlink = net->FindDouble("downlink").value_or(10.0);
-        network.rtt = net->FindDouble("rtt").value_or(50.0);
-        const std::string* s = net->FindString("effective_type");
-        if (s) {
-          network.effective_type = String::FromUTF8(s->c_str());
-        }
-        network.save_data = net->FindBool("save_data").value_or(false);
-      }
-
-      // [Battery]
-      const auto* bat = root.FindDict("battery");
-      if (bat) {
-        battery.spoofing_enabled =
-            bat->FindBool("spoofing_enabled").value_or(true);
-        battery.charging = bat->FindBool("charging").value_or(true);
-        battery.charging_time = bat->FindDouble("charging_time").value_or(0.0);
-        battery.discharging_time =
-            bat->FindDouble("discharging_time")
-                .value_or(std::numeric_limits<double>::infinity());
-        battery.level = bat->FindDouble("level").value_or(1.0);
-      }
-
-      // [WebRTC]
-      const auto* rtc = root.FindDict("webrtc");
-      if (rtc) {
-        webrtc.prevent_ip_leak =
-            rtc->FindBool("prevent_ip_leak").value_or(true);
-        webrtc_device_label_noise_max_ =
-            rtc->FindInt("device_label_noise_max").value_or(5);
-      }
-
-      // [Geo]
-      const auto* g = root.FindDict("geo");
-      if (g) {
-        geo.spoofing_enabled = g->FindBool("spoofing_enabled").value_or(true);
-        geo.latitude = g->FindDouble("latitude").value_or(geo.latitude);
-        geo.longitude = g->FindDouble("longitude").value_or(geo.longitude);
-        geo.accuracy = g->FindDouble("accuracy").value_or(geo.accuracy);
-      }
-
-      // [Timezone]
-      const auto* tz = root.FindDict("timezone");
-      if (tz) {
-        timezone.spoofing_enabled =
-            tz->FindBool("spoofing_enabled").value_or(true);
-        const std::string* s = tz->FindString("zone_id");
-        if (s) {
-          timezone.zone_id = String::FromUTF8(s->c_str());
-        }
-      }
-    }
+  // [Hardware]
+  hardware_concurrency_ = image.hardware_concurrency;
+  device_memory_ = image.device_memory;
+
+  // [Screen]
+  screen.enabled = image.HasFlag(Flag::kScreenEnabled);
+  screen.width = image.screen_width;
+  screen.height = image.screen_height;
+  screen.color_depth = image.screen_color_depth;
+
+  // [Canvas & Fonts]
+  canvas_measure_text_noise_enable_ =
+      image.HasFlag(Flag::kCanvasMeasureTextNoise);
+  canvas_fill_text_offset_max_ = image.canvas_fill_text_offset_max;
+  fonts_offset_noise_prob_percent_ = image.fonts_offset_noise_prob_percent;
+  font_whitelist_.clear();
+  font_whitelist_.reserve(static_cast<wtf_size_t>(image.font_count()));
+  for (size_t i = 0; i < image.font_count(); ++i) {
+    font_whitelist_.push_back(String::FromUTF8(image.GetFont(i)));
   }
 
-  // 4. 执行 Hook 逻辑 (无论配置来源如何，都要执行)
+  // [Audio]
+  audio_sample_rate_offset_max_ = image.audio_sample_rate_offset_max;
+  audio.spoofing_enabled = image.HasFlag(Flag::kAudioSpoofing);
+  audio.sample_rate_offset = image.audio_sample_rate_offset;
+  audio.reduction_noise_factor = image.audio_reduction_noise_factor;
+
+  // [Plugins & Rects]
+  plugins_description_noise_max_ = image.plugins_description_noise_max;
+  client_rects_noise_factor_ = image.rects_noise_factor;
+
+  // [Network]
+  network.spoofing_enabled = image.HasFlag(Flag::kNetworkSpoofing);
+  network.downlink = image.network_downlink;
+  network.rtt = image.network_rtt;
+  network.effective_type = str(image.network_effective_type);
+  network.save_data = image.HasFlag(Flag::kNetworkSaveData);
+
+  // [Battery]
+  battery.spoofing_enabled = image.HasFlag(Flag::kBatterySpoofing);
+  battery.charging = image.HasFlag(Flag::kBatteryCharging);
+  battery.charging_time = image.battery_charging_time;
+  battery.discharging_time = image.battery_discharging_time;
+  battery.level = image.battery_level;
+
+  // [WebRTC]
+  webrtc.prevent_ip_leak = image.HasFlag(Flag::kWebRTCPreventIpLeak);
+  webrtc_device_label_noise_max_ = image.webrtc_device_label_noise_max;
+
+  // [Geo]
+  geo.spoofing_enabled = image.HasFlag(Flag::kGeoSpoofing);
+  geo.latitude = image.geo_latitude;
+  geo.longitude = image.geo_longitude;
+  geo.accuracy = image.geo_accuracy;
+
+  // [Timezone]
+  timezone.spoofing_enabled = image.HasFlag(Flag::kTimezoneSpoofing);
+  timezone.zone_id = str(image.timezone_zone_id);
+}
+
+// static
+std::unique_ptr<FingerprintConfig> FingerprintConfig::LoadConfig() {
+  // The image is copied into the members by ApplyImage(), so its backing
+  // storage only has to outlive this function.
+  const FingerprintConfigImage* image = nullptr;
+  std::vector<uint8_t> image_bytes;
+  const base::CommandLine* command_line =
+      base::CommandLine::ForCurrentProcess();
 
-  // [Geo 兜底]
-  if (geo.spoofing_enabled) {
-    if (geo.latitude == 0 && geo.longitude == 0) {
-      geo.latitude = 51.5074;
-      geo.longitude = -0.1278;
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_MAC)
+  // 1. 优先：浏览器在启动时共享的只读内存区域 (零拷贝，只校验头部)
+  base::MemoryMappedFile::Region region;
+  base::ScopedFD fd = base::FileDescriptorStore::GetInstance().MaybeTakeFD(
+      kFingerprintConfigImageDescriptorKey, &region);
+  base::MemoryMappedFile mapping;
+  if (fd.is_valid()) {
+    if (mapping.Initialize(base::File(std::move(fd)), region)) {
+      image = FingerprintConfigImage::FromBytes(mapping.bytes());
     }
-  }
-
-  // [Timezone 兜底]
-  if (timezone.spoofing_enabled) {
-    if (timezone.zone_id.empty()) {
-      timezone.zone_id = "Europe/London";
+    if (!image) {
+      fprintf(stderr, "[FINGERPRINT] ERROR: Invalid shared config image.\n");
     }
   }
-
-  // [Timezone Hook]
-  if (timezone.spoofing_enabled && !timezone.zone_id.empty()) {
-    std::string tz_str = timezone.zone_id.Utf8().data();
-
-#if BUILDFLAG(IS_WIN)
-    // 1. 设置环境变量
-    _putenv_s("TZ", tz_str.c_str());
-    // 2. [核心] 必须调用这个函数，Windows 的 Date 库才会刷新！
-    _tzset();
-#else
-    setenv("TZ", tz_str.c_str(), 1);
-    tzset();
 #endif
 
-    // 1. 设置 ICU 默认时区 (C++ 层)
-    icu::UnicodeString tz_id(timezone.zone_id.Utf8().c_str());
-    std::unique_ptr<icu::TimeZone> zone(icu::TimeZone::createTimeZone(tz_id));
-
-    if (*zone == icu::TimeZone::getUnknown()) {
-      fprintf(stderr, "[FINGERPRINT] ERROR: Invalid Timezone ID: %s\n",
-              timezone.zone_id.Utf8().c_str());
-    } else {
-      icu::TimeZone::adoptDefault(zone.release());
-      fprintf(stderr, "[FINGERPRINT] SUCCESS: ICU Timezone set to %s\n",
-              timezone.zone_id.Utf8().c_str());
+  // 2. 其次：命令行携带的二进制镜像 (Base64，无 JSON 解析)
+  if (!image && command_line->HasSwitch(kFingerprintConfigImageSwitch)) {
+    std::optional<std::vector<uint8_t>> decoded = base::Base64Decode(
+        command_line->GetSwitchValueASCII(kFingerprintConfigImageSwitch));
+    if (decoded) {
+      image_bytes = std::move(*decoded);
+      image = FingerprintConfigImage::FromBytes(image_bytes);
+    }
+    if (!image) {
+      fprintf(stderr,
+              "[FINGERPRINT] ERROR: Failed to decode command line config.\n");
     }
-
-    // 2. [新增] 设置系统环境变量 TZ (针对 libc/windows CRT)
-    // 某些底层库不走 ICU，而是看环境变量
-    std::string env_tz_val = timezone.zone_id.Utf8();
-#if BUILDFLAG(IS_WIN)
-    _putenv_s("TZ", env_tz_val.c_str());
-#else
-    setenv("TZ", env_tz_val.c_str(), 1);
-    tzset();  // 刷新 POSIX 时区信息
-#endif
   }
-  is_loaded_ = true;
-  EnforceTimezone();
-}
 
-void FingerprintConfig::EnforceTimezone() {
-  // 必须确保配置已加载
-  if (!is_loaded_) {
-    return;
+  // 身份随后经 FingerprintConfigAgent 下发 (备用进程或身份尚在编译时启动的
+  // 进程)：不读文件、不用内置默认身份，先用不伪装时区的成员默认值占位，
+  // 时区等到 Publish() 时再应用。
+  if (!image && command_line->HasSwitch(kFingerprintIdentityPendingSwitch)) {
+    return base::WrapUnique(new FingerprintConfig());
   }
 
-  // ================= [FINGERPRINT DYNAMIC START] =================
-  // 使用成员变量 (timezone.zone_id)，它是由 LoadConfig 从 JSON 解析出来的
-  if (timezone.spoofing_enabled && !timezone.zone_id.empty()) {
-    std::string tz_str = timezone.zone_id.Utf8().data();
-
-    // 1. 设置系统环境
-#if BUILDFLAG(IS_WIN)
-    _putenv_s("TZ", tz_str.c_str());
-    _tzset();
-#else
-    setenv("TZ", tz_str.c_str(), 1);
-    tzset();
-#endif
-
-    // 2. 设置 ICU
-    icu::UnicodeString tz_id(timezone.zone_id.Utf8().c_str());
-    std::unique_ptr<icu::TimeZone> zone(icu::TimeZone::createTimeZone(tz_id));
-
-    if (*zone != icu::TimeZone::getUnknown()) {
-      icu::TimeZone::adoptDefault(zone.release());
+  // 3. 备用：直接读取文件 (仅在 --no-sandbox 模式或特定环境下有效)，
+  //    否则使用内置默认配置
+  if (!image) {
+    std::string config_content;
+    base::FilePath exe_path;
+    if (!base::PathService::Get(base::DIR_EXE, &exe_path) ||
+        !base::ReadFileToString(exe_path.AppendASCII("fingerprint.json"),
+                                &config_content)) {
+      config_content = kDefaultConfigJson;
+      fprintf(stderr, "[FINGERPRINT] using built-in default config.\n");
     }
-
-    LOG(ERROR) << ">>> [FINGERPRINT] EnforceTimezone applied dynamically: "
-               << tz_str;
+    auto result =
+        base::JSONReader::ReadAndReturnValueWithError(config_content, 0);
+    image_bytes = FingerprintConfigImage::Compile(
+        result.has_value() && result->is_dict() ? result->GetDict()
+                                                : base::Value::Dict());
+    image = FingerprintConfigImage::FromBytes(image_bytes);
+    CHECK(image);
   }
-  // ================= [FINGERPRINT DYNAMIC END] =================
+
+  auto config = base::WrapUnique(new FingerprintConfig());
+  config->ApplyImage(*image);
+
+  // Geo/Timezone 兜底已在 FingerprintConfigImage::Compile 中完成；时区由
+  // FingerprintTimezone 在首次发布快照时统一应用。
+  return config;
 }
 
 double FingerprintConfig::GenerateNoise(double input, double factor) {
-  // 1. 获取当前实例中的种子 (从 JSON 读来的那个 12345)
-  int seed = Instance().GetGlobalSeed();
-
-  // 2. 核心算法：sin(种子 + 输入 + 偏移)
-  // 增加常量偏移 (0.12345) 防止 seed=0 && input=0 时结果为 0
-  double deterministic_val =
-      std::sin(static_cast<double>(seed) + input + 0.12345);
+  // 计数器式 PRNG：同一 seed、同一 input 永远得到同一噪声，且与调用顺序无关
+  return FingerprintNoise(FingerprintNoiseDomain::kGeneric)
+             .Signed(FingerprintNoise::CounterFromDouble(input)) *
+         factor;
+}
 
-  return deterministic_val * factor;
+double FingerprintConfig::RectsNoise(double value, double factor) {
+  const uint64_t counter = static_cast<uint64_t>(std::llround(value * 10000.0));
+  return FingerprintNoise(FingerprintNoiseDomain::kRects).Signed(counter) *
+         factor;
 }
 
 }  // namespace blink
@@ -1,23 +1,48 @@
 ﻿#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_CONFIG_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_CONFIG_H_
 
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+
+#include "base/containers/span.h"
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 
 namespace blink {
 
+struct FingerprintConfigImage;
+
+// An immutable snapshot of fingerprint.json. The current snapshot is read
+// through a single atomic pointer load and may be replaced at any time by
+// Publish() (RCU-style); a snapshot never changes after it is published.
+//
+// Snapshots are never freed, so a reference from Instance() stays valid on
+// any thread for the life of the process, and callers that must see one
+// identity across tasks simply keep it. Retention is bounded by the number
+// of distinct identities the browser pushes: it only sends a snapshot when
+// the compiled image actually changed, and each one is a few KB.
 class CORE_EXPORT FingerprintConfig {
   USING_FAST_MALLOC(FingerprintConfig);
 
  public:
   static bool IsCanvasNoiseEnabled();
   static bool IsFontNoiseEnabled();
-  static FingerprintConfig* GetInstance();
-  static FingerprintConfig& Instance();
+  static const FingerprintConfig* GetInstance();
+  static const FingerprintConfig& Instance();
+  // Atomically replaces the current snapshot with one built from a compiled
+  // image. Returns false if |image_bytes| is not a valid image.
+  static bool Publish(base::span<const uint8_t> image_bytes);
+  // Deterministic noise in [-factor, factor) for |input|, keyed by the
+  // global seed (FingerprintNoiseDomain::kGeneric).
   static double GenerateNoise(double input, double factor);
-  void LoadConfig();
-  void EnforceTimezone();
+  // Noise in [-factor, factor) for a DOMRect coordinate. |value| is quantized
+  // to 1e-4 px so that layout jitter below that does not change the noise.
+  static double RectsNoise(double value, double factor);
   // =========================================================
   // 1. 结构体定义 (类型定义)
   // =========================================================
@@ -112,6 +137,29 @@ class CORE_EXPORT FingerprintConfig {
   float GetWebGLClearColorNoise() const;
   int GetWebGLViewportNoiseMax() const;
   int GetWebGLReadPixelsNoiseMax() const;
+  // Render-exact mode: viewport() and clearColor() are passed through as
+  // given, and WebGL output is only perturbed where it is read back.
+  bool GetWebGLRenderExact() const;
+
+  // WebGL GPU profile: values WebGL answers locally, without a GPU process
+  // round trip. Each part is optional and the getters return nullptr /
+  // nullopt when the identity does not give it.
+  struct WebGLParameter {
+    wtf_size_t count = 0;
+    std::array<double, 4> values = {};
+  };
+  struct WebGLShaderPrecision {
+    int range_min = 0;
+    int range_max = 0;
+    int precision = 0;
+  };
+  const WebGLParameter* GetWebGLParameter(uint32_t pname) const;
+  const WebGLShaderPrecision* GetWebGLShaderPrecision(
+      uint32_t shader_type,
+      uint32_t precision_type) const;
+  const Vector<String>* GetWebGLExtensions() const;
+  std::optional<bool> GetWebGLAntialias() const;
+
   int GetCanvasFillTextOffsetMax() const;
   bool GetCanvasMeasureTextNoiseEnable() const;
   int GetAudioSampleRateOffsetMax() const;
@@ -127,8 +175,16 @@ class CORE_EXPORT FingerprintConfig {
   int global_seed_ = 0;
   double client_rects_noise_factor_ = 0.000005;
   int fonts_offset_noise_prob_percent_ = 0;
+
   FingerprintConfig();
-  ~FingerprintConfig() = default;
+
+  // Slow path of Instance(): builds and publishes the initial snapshot.
+  static const FingerprintConfig& InitializeCurrent();
+  static std::unique_ptr<FingerprintConfig> LoadConfig();
+  static void PublishLocked(std::unique_ptr<FingerprintConfig> snapshot);
+
+  // Copies the compiled image produced by the browser into the members below.
+  void ApplyImage(const FingerprintConfigImage& image);
 
   // 内部私有变量
   String webgl_vendor_ = "Google Inc. (NVIDIA)";
@@ -137,6 +193,12 @@ class CORE_EXPORT FingerprintConfig {
   float webgl_clear_color_noise_ = 0.005f;
   int webgl_viewport_noise_max_ = 15;
   int webgl_read_pixels_noise_max_ = 3;
+  bool webgl_render_exact_ = false;
+  HashMap<uint32_t, WebGLParameter> webgl_parameters_;
+  // Keyed by (shader_type << 16) | precision_type.
+  HashMap<uint32_t, WebGLShaderPrecision> webgl_shader_precisions_;
+  std::optional<Vector<String>> webgl_extensions_;
+  std::optional<bool> webgl_antialias_;
   int canvas_fill_text_offset_max_ = 3;
   bool canvas_measure_text_noise_enable_ = true;
   int audio_sample_rate_offset_max_ = 99;
@@ -145,7 +207,6 @@ class CORE_EXPORT FingerprintConfig {
   int plugins_description_noise_max_ = 9;
   int webrtc_device_label_noise_max_ = 9;
   Vector<String> font_whitelist_;
-  bool is_loaded_ = false;
 };
 
 }  // namespace blink
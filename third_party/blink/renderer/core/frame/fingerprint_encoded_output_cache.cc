@@ -0,0 +1,205 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/frame/fingerprint_encoded_output_cache.h"
+
+#include <utility>
+
+#include "third_party/blink/renderer/core/fileapi/blob.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/html/canvas/canvas_async_blob_creator.h"
+#include "third_party/blink/renderer/core/html/canvas/canvas_rendering_context_host.h"
+#include "third_party/blink/renderer/platform/blob/blob_data.h"
+
+namespace blink {
+
+// static
+const char FingerprintEncodedOutputCache::kSupplementName[] =
+    "FingerprintEncodedOutputCache";
+
+bool FingerprintEncodedOutputCache::Key::operator==(const Key& other) const {
+  return mime_type == other.mime_type && quality == other.quality &&
+         source_buffer == other.source_buffer &&
+         color_type == other.color_type &&
+         SkColorSpace::Equals(color_space.get(), other.color_space.get()) &&
+         seed == other.seed && noised == other.noised;
+}
+
+// static
+FingerprintEncodedOutputCache::Key FingerprintEncodedOutputCache::MakeKey(
+    const CanvasRenderingContextHost& host,
+    ImageEncodingMimeType mime_type,
+    double quality,
+    int source_buffer) {
+  const SkColorInfo color_info = host.GetRenderingContextSkColorInfo();
+  // Both fields from one snapshot, as FingerprintCanvasReadback reads them.
+  const FingerprintConfig& identity = FingerprintConfig::Instance();
+  return Key{mime_type,
+             quality,
+             source_buffer,
+             color_info.colorType(),
+             color_info.refColorSpace(),
+             identity.GetGlobalSeed(),
+             identity.GetCanvasMeasureTextNoiseEnable()};
+}
+
+FingerprintEncodedOutputCache::FingerprintEncodedOutputCache(
+    ExecutionContext& context)
+    : Supplement<ExecutionContext>(context) {}
+
+// static
+FingerprintEncodedOutputCache* FingerprintEncodedOutputCache::From(
+    const CanvasRenderingContextHost& host,
+    bool create) {
+  ExecutionContext* context = host.GetTopExecutionContext();
+  if (!context || context->IsContextDestroyed()) {
+    return nullptr;
+  }
+  auto* cache =
+      Supplement<ExecutionContext>::From<FingerprintEncodedOutputCache>(
+          context);
+  if (!cache && create) {
+    cache = MakeGarbageCollected<FingerprintEncodedOutputCache>(*context);
+    ProvideTo(*context, cache);
+  }
+  return cache;
+}
+
+FingerprintEncodedOutputCache::Outputs::Entry*
+FingerprintEncodedOutputCache::Outputs::Find(const Key& key) {
+  for (Entry& entry : entries_) {
+    if (entry.key == key) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+FingerprintEncodedOutputCache::Outputs::Entry&
+FingerprintEncodedOutputCache::Outputs::FindOrAdd(const Key& key) {
+  if (Entry* entry = Find(key)) {
+    return *entry;
+  }
+  if (entries_.size() == kMaxEntries) {
+    entries_.EraseAt(0);
+  }
+  entries_.push_back(Entry{key, String(), nullptr});
+  return entries_.back();
+}
+
+FingerprintEncodedOutputCache::Outputs::Entry*
+FingerprintEncodedOutputCache::Find(const CanvasRenderingContextHost& host,
+                                    const Key& key) {
+  auto it = outputs_.find(&host);
+  return it == outputs_.end() ? nullptr : it->value->Find(key);
+}
+
+FingerprintEncodedOutputCache::Outputs&
+FingerprintEncodedOutputCache::OutputsFor(
+    const CanvasRenderingContextHost& host) {
+  auto result = outputs_.insert(&host, nullptr);
+  if (result.is_new_entry) {
+    result.stored_value->value =
+        MakeGarbageCollected<Outputs>(++next_generation_);
+  }
+  return *result.stored_value->value;
+}
+
+FingerprintEncodedOutputCache::PendingBlob::PendingBlob(
+    const CanvasRenderingContextHost& host,
+    const Key& key,
+    uint64_t generation)
+    : host(&host), key(key), generation(generation) {}
+
+void FingerprintEncodedOutputCache::PendingBlob::Trace(
+    Visitor* visitor) const {
+  visitor->Trace(host);
+}
+
+// static
+String FingerprintEncodedOutputCache::GetDataURL(
+    const CanvasRenderingContextHost& host,
+    const Key& key) {
+  FingerprintEncodedOutputCache* cache = From(host, /*create=*/false);
+  Outputs::Entry* entry = cache ? cache->Find(host, key) : nullptr;
+  return entry ? entry->data_url : String();
+}
+
+// static
+void FingerprintEncodedOutputCache::PutDataURL(
+    const CanvasRenderingContextHost& host,
+    const Key& key,
+    const String& data_url) {
+  if (FingerprintEncodedOutputCache* cache = From(host, /*create=*/true)) {
+    cache->OutputsFor(host).FindOrAdd(key).data_url = data_url;
+  }
+}
+
+// static
+Blob* FingerprintEncodedOutputCache::GetBlob(
+    const CanvasRenderingContextHost& host,
+    const Key& key) {
+  FingerprintEncodedOutputCache* cache = From(host, /*create=*/false);
+  Outputs::Entry* entry = cache ? cache->Find(host, key) : nullptr;
+  if (!entry || !entry->blob) {
+    return nullptr;
+  }
+  return MakeGarbageCollected<Blob>(entry->blob);
+}
+
+// static
+void FingerprintEncodedOutputCache::ExpectBlob(
+    const CanvasRenderingContextHost& host,
+    const Key& key,
+    const CanvasAsyncBlobCreator& creator) {
+  if (FingerprintEncodedOutputCache* cache = From(host, /*create=*/true)) {
+    cache->pending_blobs_.Set(
+        &creator, MakeGarbageCollected<PendingBlob>(
+                      host, key, cache->OutputsFor(host).generation()));
+  }
+}
+
+// static
+void FingerprintEncodedOutputCache::DidCreateBlob(
+    ExecutionContext* context,
+    const CanvasAsyncBlobCreator& creator,
+    const Blob& blob) {
+  if (!context) {
+    return;
+  }
+  auto* cache =
+      Supplement<ExecutionContext>::From<FingerprintEncodedOutputCache>(
+          context);
+  if (!cache) {
+    return;
+  }
+  PendingBlob* pending = cache->pending_blobs_.Take(&creator);
+  if (!pending || !pending->host) {
+    return;
+  }
+  auto it = cache->outputs_.find(pending->host.Get());
+  // A new generation has started since the snapshot was taken: the blob
+  // holds content the canvas no longer shows.
+  if (it == cache->outputs_.end() ||
+      it->value->generation() != pending->generation) {
+    return;
+  }
+  it->value->FindOrAdd(pending->key).blob = blob.GetBlobDataHandle();
+}
+
+// static
+void FingerprintEncodedOutputCache::Invalidate(
+    const CanvasRenderingContextHost& host) {
+  if (FingerprintEncodedOutputCache* cache = From(host, /*create=*/false)) {
+    cache->outputs_.erase(&host);
+  }
+}
+
+void FingerprintEncodedOutputCache::Trace(Visitor* visitor) const {
+  visitor->Trace(outputs_);
+  visitor->Trace(pending_blobs_);
+  Supplement<ExecutionContext>::Trace(visitor);
+}
+
+}  // namespace blink
@@ -0,0 +1,151 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_ENCODED_OUTPUT_CACHE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_ENCODED_OUTPUT_CACHE_H_
+
+#include <stdint.h>
+
+#include "base/memory/scoped_refptr.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/execution_context/execution_context.h"
+#include "third_party/blink/renderer/platform/heap/collection_support/heap_hash_map.h"
+#include "third_party/blink/renderer/platform/heap/garbage_collected.h"
+#include "third_party/blink/renderer/platform/heap/member.h"
+#include "third_party/blink/renderer/platform/image-encoders/image_encoder_utils.h"
+#include "third_party/blink/renderer/platform/supplementable.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace blink {
+
+class Blob;
+class BlobDataHandle;
+class CanvasAsyncBlobCreator;
+class CanvasRenderingContextHost;
+
+// Encoded toDataURL() / toBlob() / convertToBlob() results of 2D canvases, so
+// that exporting an unchanged canvas again skips the snapshot, readback,
+// noise and encode and returns byte-identical output.
+//
+// Entries belong to the host's current content generation: DidDraw() and
+// every size change or reset call Invalidate(), which starts a new
+// generation. Within a generation, entries are keyed by mime type, quality,
+// source buffer, colour space and the identity's seed and canvas noise
+// switch. Blobs are encoded
+// asynchronously, so they are only stored if no new generation started while
+// they were being encoded. Hosts are held weakly, one table per execution
+// context.
+class CORE_EXPORT FingerprintEncodedOutputCache final
+    : public GarbageCollected<FingerprintEncodedOutputCache>,
+      public Supplement<ExecutionContext> {
+ public:
+  static const char kSupplementName[];
+
+  struct Key {
+    DISALLOW_NEW();
+
+    ImageEncodingMimeType mime_type;
+    double quality;
+    int source_buffer;
+    SkColorType color_type;
+    sk_sp<SkColorSpace> color_space;
+    // The identity's seed and whether it enables canvas noise: exports made
+    // under a different identity must not be returned.
+    int32_t seed;
+    bool noised;
+
+    bool operator==(const Key& other) const;
+  };
+
+  // Key for exporting |host|'s current content. |source_buffer| is the
+  // SourceDrawingBuffer for toDataURL() and 0 otherwise.
+  static Key MakeKey(const CanvasRenderingContextHost& host,
+                     ImageEncodingMimeType mime_type,
+                     double quality,
+                     int source_buffer);
+
+  // Returns a null String / nullptr on a miss.
+  static String GetDataURL(const CanvasRenderingContextHost& host,
+                           const Key& key);
+  static void PutDataURL(const CanvasRenderingContextHost& host,
+                         const Key& key,
+                         const String& data_url);
+  // A hit is a new Blob sharing the cached blob's data.
+  static Blob* GetBlob(const CanvasRenderingContextHost& host, const Key& key);
+  // Records that |creator| encodes |host|'s current generation for |key|;
+  // DidCreateBlob() then stores its result.
+  static void ExpectBlob(const CanvasRenderingContextHost& host,
+                         const Key& key,
+                         const CanvasAsyncBlobCreator& creator);
+  static void DidCreateBlob(ExecutionContext* context,
+                            const CanvasAsyncBlobCreator& creator,
+                            const Blob& blob);
+
+  // Called whenever |host|'s content or size may have changed. Cheap when
+  // nothing is cached, which is the common case on the DidDraw() path.
+  static void Invalidate(const CanvasRenderingContextHost& host);
+
+  explicit FingerprintEncodedOutputCache(ExecutionContext& context);
+
+  void Trace(Visitor* visitor) const override;
+
+ private:
+  // Per host: the last few distinct exports of the current generation.
+  class Outputs final : public GarbageCollected<Outputs> {
+   public:
+    struct Entry {
+      Key key;
+      String data_url;
+      scoped_refptr<BlobDataHandle> blob;
+    };
+
+    explicit Outputs(uint64_t generation) : generation_(generation) {}
+
+    uint64_t generation() const { return generation_; }
+
+    Entry* Find(const Key& key);
+    Entry& FindOrAdd(const Key& key);
+
+    void Trace(Visitor*) const {}
+
+   private:
+    static constexpr wtf_size_t kMaxEntries = 4;
+
+    const uint64_t generation_;
+    Vector<Entry> entries_;
+  };
+
+  // A toBlob() / convertToBlob() encode in flight.
+  class PendingBlob final : public GarbageCollected<PendingBlob> {
+   public:
+    PendingBlob(const CanvasRenderingContextHost& host,
+                const Key& key,
+                uint64_t generation);
+
+    void Trace(Visitor* visitor) const;
+
+    WeakMember<const CanvasRenderingContextHost> host;
+    const Key key;
+    const uint64_t generation;
+  };
+
+  static FingerprintEncodedOutputCache* From(
+      const CanvasRenderingContextHost& host,
+      bool create);
+  Outputs::Entry* Find(const CanvasRenderingContextHost& host, const Key& key);
+  Outputs& OutputsFor(const CanvasRenderingContextHost& host);
+
+  HeapHashMap<WeakMember<const CanvasRenderingContextHost>, Member<Outputs>>
+      outputs_;
+  HeapHashMap<WeakMember<const CanvasAsyncBlobCreator>, Member<PendingBlob>>
+      pending_blobs_;
+  uint64_t next_generation_ = 0;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_ENCODED_OUTPUT_CACHE_H_
@@ -0,0 +1,130 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/frame/fingerprint_image_data_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "third_party/blink/renderer/core/html/canvas/canvas_rendering_context_host.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
+#include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
+
+namespace blink {
+
+namespace {
+
+// Whether the pool's share is the only reference left to |contents|' store.
+// BackingStore() returns a second, temporary one; every live ArrayBuffer,
+// here or in another context it was transferred to, adds one more.
+bool IsOnlyHeldByPool(const ArrayBufferContents& contents) {
+  return contents.BackingStore().use_count() <= 2;
+}
+
+}  // namespace
+
+// static
+const char FingerprintImageDataPool::kSupplementName[] =
+    "FingerprintImageDataPool";
+
+FingerprintImageDataPool::FingerprintImageDataPool(ExecutionContext& context)
+    : Supplement<ExecutionContext>(context) {}
+
+// static
+FingerprintImageDataPool* FingerprintImageDataPool::From(
+    const CanvasRenderingContextHost& host,
+    bool create) {
+  ExecutionContext* context = host.GetTopExecutionContext();
+  if (!context || context->IsContextDestroyed()) {
+    return nullptr;
+  }
+  auto* pool =
+      Supplement<ExecutionContext>::From<FingerprintImageDataPool>(context);
+  if (!pool && create) {
+    pool = MakeGarbageCollected<FingerprintImageDataPool>(*context);
+    ProvideTo(*context, pool);
+  }
+  return pool;
+}
+
+FingerprintImageDataPool::Buffers::Slot*
+FingerprintImageDataPool::Buffers::FindFree(const gfx::Size& size,
+                                            PredefinedColorSpace color_space) {
+  for (Slot& slot : slots_) {
+    if (slot.size == size && slot.color_space == color_space &&
+        IsOnlyHeldByPool(slot.contents)) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+void FingerprintImageDataPool::Buffers::Add(Slot slot) {
+  if (slots_.size() == kMaxSlots) {
+    slots_.EraseAt(0);
+  }
+  slots_.push_back(std::move(slot));
+}
+
+// static
+ImageData* FingerprintImageDataPool::Take(
+    const CanvasRenderingContextHost& host,
+    const gfx::Size& size,
+    const ImageData::ValidateAndCreateParams& params,
+    ExceptionState& exception_state) {
+  FingerprintImageDataPool* pool = From(host, /*create=*/false);
+  if (!pool) {
+    return nullptr;
+  }
+  auto it = pool->buffers_.find(&host);
+  if (it == pool->buffers_.end()) {
+    return nullptr;
+  }
+  Buffers::Slot* slot = it->value->FindFree(size, params.default_color_space);
+  if (!slot) {
+    return nullptr;
+  }
+  // The slot keeps sharing the store, so it is free again as soon as the new
+  // ImageData is dropped as well.
+  ArrayBufferContents contents;
+  slot->contents.ShareNonSharedForInternalUse(contents);
+  if (params.zero_initialize) {
+    std::ranges::fill(contents.ByteSpan(), 0);
+  }
+  const size_t byte_length = contents.DataLength();
+  DOMUint8ClampedArray* array = DOMUint8ClampedArray::Create(
+      DOMArrayBuffer::Create(std::move(contents)), 0, byte_length);
+  return ImageData::ValidateAndCreate(
+      size.width(), size.height(), NotShared<DOMArrayBufferView>(array),
+      /*settings=*/nullptr, params, exception_state);
+}
+
+// static
+void FingerprintImageDataPool::Track(const CanvasRenderingContextHost& host,
+                                     const ImageData& image_data,
+                                     PredefinedColorSpace color_space) {
+  DOMArrayBufferBase* buffer = image_data.BufferBase();
+  if (!buffer || buffer->IsShared() || buffer->IsDetached()) {
+    return;
+  }
+  FingerprintImageDataPool* pool = From(host, /*create=*/true);
+  if (!pool) {
+    return;
+  }
+  auto result = pool->buffers_.insert(&host, nullptr);
+  if (result.is_new_entry) {
+    result.stored_value->value = MakeGarbageCollected<Buffers>();
+  }
+  Buffers::Slot slot{image_data.Size(), color_space, ArrayBufferContents()};
+  buffer->Content()->ShareNonSharedForInternalUse(slot.contents);
+  result.stored_value->value->Add(std::move(slot));
+}
+
+void FingerprintImageDataPool::Trace(Visitor* visitor) const {
+  visitor->Trace(buffers_);
+  Supplement<ExecutionContext>::Trace(visitor);
+}
+
+}  // namespace blink
@@ -0,0 +1,91 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_IMAGE_DATA_POOL_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_IMAGE_DATA_POOL_H_
+
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/execution_context/execution_context.h"
+#include "third_party/blink/renderer/core/html/canvas/image_data.h"
+#include "third_party/blink/renderer/core/typed_arrays/array_buffer/array_buffer_contents.h"
+#include "third_party/blink/renderer/platform/graphics/graphics_types.h"
+#include "third_party/blink/renderer/platform/heap/collection_support/heap_hash_map.h"
+#include "third_party/blink/renderer/platform/heap/garbage_collected.h"
+#include "third_party/blink/renderer/platform/heap/member.h"
+#include "third_party/blink/renderer/platform/supplementable.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace blink {
+
+class CanvasRenderingContextHost;
+class ExceptionState;
+
+// Recycles the pixel buffers of getImageData() results on willReadFrequently
+// 2D canvases, which pages typically read every frame: without it each read
+// allocates a new ImageData backing store and the old ones pile up until
+// the next GC.
+//
+// Each buffer handed out is remembered by sharing its backing store. Once
+// nothing but the pool references that store any more - the page dropped
+// the ImageData and its array, and did not transfer the buffer - a later
+// read of the same size and colour space wraps it in a new ImageData instead
+// of allocating. getImageData() then reads the canvas straight into it and
+// noises it in place, as it does with a fresh buffer. Only 8-bit RGBA
+// results without explicit ImageDataSettings are pooled. Hosts are held
+// weakly, one table per execution context.
+class CORE_EXPORT FingerprintImageDataPool final
+    : public GarbageCollected<FingerprintImageDataPool>,
+      public Supplement<ExecutionContext> {
+ public:
+  static const char kSupplementName[];
+
+  // A recycled ImageData of |size| for |host|, or nullptr if none is free.
+  // Its pixels are stale unless |params| asks for zero initialization.
+  static ImageData* Take(const CanvasRenderingContextHost& host,
+                         const gfx::Size& size,
+                         const ImageData::ValidateAndCreateParams& params,
+                         ExceptionState& exception_state);
+  // Remembers the buffer of |image_data|, newly allocated for |host|, so
+  // that it can be recycled once the page lets go of it.
+  static void Track(const CanvasRenderingContextHost& host,
+                    const ImageData& image_data,
+                    PredefinedColorSpace color_space);
+
+  explicit FingerprintImageDataPool(ExecutionContext& context);
+
+  void Trace(Visitor* visitor) const override;
+
+ private:
+  // Per host: the buffers of its last few reads.
+  class Buffers final : public GarbageCollected<Buffers> {
+   public:
+    struct Slot {
+      gfx::Size size;
+      PredefinedColorSpace color_space;
+      ArrayBufferContents contents;
+    };
+
+    Slot* FindFree(const gfx::Size& size, PredefinedColorSpace color_space);
+    void Add(Slot slot);
+
+    void Trace(Visitor*) const {}
+
+   private:
+    // Enough for double-buffered reads of a couple of regions.
+    static constexpr wtf_size_t kMaxSlots = 4;
+
+    Vector<Slot> slots_;
+  };
+
+  static FingerprintImageDataPool* From(const CanvasRenderingContextHost& host,
+                                        bool create);
+
+  HeapHashMap<WeakMember<const CanvasRenderingContextHost>, Member<Buffers>>
+      buffers_;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_IMAGE_DATA_POOL_H_
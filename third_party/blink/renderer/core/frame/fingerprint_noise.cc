@@ -0,0 +1,155 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+
+#include <string.h>
+
+#include <array>
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/hash/hash.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/platform/fonts/font_description.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_impl.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
+
+namespace blink {
+
+namespace {
+
+// Strings at least this long get their counter cached; shorter ones are
+// cheaper to hash than to look up.
+constexpr wtf_size_t kMinCachedStringLength = 64;
+
+uint64_t HashStringContent(const String& value) {
+  if (value.Is8Bit()) {
+    return base::FastHash(base::as_bytes(value.Span8()));
+  }
+  if (value.ContainsOnlyLatin1OrEmpty()) {
+    const std::string latin1 = value.Latin1();
+    return base::FastHash(base::as_byte_span(latin1));
+  }
+  return base::FastHash(base::as_bytes(value.Span16()));
+}
+
+// Content hash of the first and last kEdgeLength code units, which checks a
+// StringCounterCache hit in constant time.
+constexpr wtf_size_t kEdgeLength = 32;
+static_assert(2 * kEdgeLength <= kMinCachedStringLength);
+
+uint64_t HashStringEdges(const String& value) {
+  if (value.Is8Bit()) {
+    const auto chars = value.Span8();
+    return base::FastHash(base::as_bytes(chars.first(kEdgeLength))) ^
+           base::FastHash(base::as_bytes(chars.last(kEdgeLength))) * 3;
+  }
+  const auto chars = value.Span16();
+  return base::FastHash(base::as_bytes(chars.first(kEdgeLength))) ^
+         base::FastHash(base::as_bytes(chars.last(kEdgeLength))) * 3;
+}
+
+// 长字符串的内容计数器按 StringImpl 身份缓存：页面在循环里反复 measureText
+// 同一个 JS 字符串时拿到的是同一个 StringImpl，只在第一次扫描全文。槽位不
+// 持有引用（否则会让任意大的字符串在 GC 后仍常驻），只记地址、长度、
+// StringImpl 自带的 24 位哈希，以及首尾各 32 个字符的内容哈希；全部相同才
+// 算命中。地址被新字符串复用时，只有长度、24 位哈希和首尾内容都与旧串相同
+// （即只在中间不同且 StringHasher 碰撞）才会误用旧串的计数器：偶然发生的
+// 概率约为 2^-24 再乘以首尾恰好相同的概率；蓄意构造则还需要控制分配器复用
+// 同一地址。误命中的后果只是该串得到旧串的噪声。每线程一张直接映射表，
+// 冲突时直接覆盖。
+class StringCounterCache {
+  USING_FAST_MALLOC(StringCounterCache);
+
+ public:
+  static StringCounterCache& ForCurrentThread() {
+    DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<StringCounterCache>,
+                                    caches, ());
+    return *caches;
+  }
+
+  uint64_t CounterFor(const String& value) {
+    const StringImpl* impl = value.Impl();
+    const uintptr_t address = reinterpret_cast<uintptr_t>(impl);
+    Slot& slot = slots_[((address >> 4) ^ (address >> 12)) & (kSlots - 1)];
+    // GetHash() is computed once and then stored in the StringImpl.
+    const unsigned hash = impl->GetHash();
+    const uint64_t edge_hash = HashStringEdges(value);
+    if (slot.address != address || slot.length != impl->length() ||
+        slot.hash != hash || slot.edge_hash != edge_hash) {
+      slot.counter = HashStringContent(value);
+      slot.address = address;
+      slot.length = impl->length();
+      slot.hash = hash;
+      slot.edge_hash = edge_hash;
+    }
+    return slot.counter;
+  }
+
+ private:
+  static constexpr size_t kSlots = 256;
+
+  struct Slot {
+    uintptr_t address = 0;
+    wtf_size_t length = 0;
+    unsigned hash = 0;
+    uint64_t edge_hash = 0;
+    uint64_t counter = 0;
+  };
+
+  std::array<Slot, kSlots> slots_;
+};
+
+}  // namespace
+
+FingerprintNoise::FingerprintNoise(FingerprintNoiseDomain domain)
+    : FingerprintNoise(FingerprintConfig::Instance().GetGlobalSeed(), domain) {}
+
+FingerprintNoise::FingerprintNoise(int32_t seed, FingerprintNoiseDomain domain)
+    : key_(Mix((static_cast<uint64_t>(static_cast<uint32_t>(seed)) << 32) |
+               static_cast<uint32_t>(domain))) {}
+
+void FingerprintNoise::FillBits(uint64_t first,
+                                base::span<uint8_t> out) const {
+  for (size_t i = 0; i < out.size(); ++i) {
+    out[i] = static_cast<uint8_t>(Bits(first + i) >> 56);
+  }
+}
+
+// static
+uint64_t FingerprintNoise::CounterFromDouble(double value) {
+  if (value == 0) {
+    value = 0;  // Folds -0 into +0.
+  }
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// static
+uint64_t FingerprintNoise::CounterFromString(const String& value) {
+  if (value.empty()) {
+    return 0;
+  }
+  if (value.length() < kMinCachedStringLength) {
+    return HashStringContent(value);
+  }
+  return StringCounterCache::ForCurrentThread().CounterFor(value);
+}
+
+// static
+uint64_t FingerprintNoise::CounterFromFont(const FontDescription& description) {
+  constexpr uint64_t kPrime = 0x100000001B3ull;
+  uint64_t counter = CounterFromString(description.Family().FamilyName());
+  counter = counter * kPrime ^ CounterFromDouble(description.ComputedSize());
+  counter = counter * kPrime ^
+            CounterFromDouble(static_cast<float>(description.Weight()));
+  counter = counter * kPrime ^
+            CounterFromDouble(static_cast<float>(description.Style()));
+  return counter;
+}
+
+}  // namespace blink
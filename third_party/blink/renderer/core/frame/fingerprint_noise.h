@@ -0,0 +1,98 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_NOISE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_NOISE_H_
+
+#include <stdint.h>
+
+#include "base/containers/span.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+namespace blink {
+
+class FontDescription;
+
+// Separates the noise streams of different hooks so that, under the same
+// global seed, e.g. canvas pixels and client rects never see correlated
+// values. Values are part of the key: never renumber them.
+enum class FingerprintNoiseDomain : uint32_t {
+  kGeneric = 0,
+  kCanvasPixels = 1,
+  kCanvasText = 2,
+  kCanvasEncoding = 3,
+  kRects = 4,
+  kFonts = 5,
+  kAudio = 6,
+  kWebGL = 7,
+  kMeasureText = 8,
+  kTextDraw = 9,
+};
+
+// Keyed, counter-based noise generator.
+//
+// Every value is a pure function of (seed, domain, counter): there is no
+// hidden state, so results do not depend on call order and any element of a
+// stream can be computed independently. Bits() is SplitMix64's finalizer over
+// key + counter * golden-ratio; it is cheap enough to call per pixel and
+// replaces the old sin(seed + input) generator, whose output was visibly
+// periodic and correlated across neighbouring inputs.
+class CORE_EXPORT FingerprintNoise {
+  DISALLOW_NEW();
+
+ public:
+  // Keyed with the current identity's global seed.
+  explicit FingerprintNoise(FingerprintNoiseDomain domain);
+  FingerprintNoise(int32_t seed, FingerprintNoiseDomain domain);
+
+  // 64 uniformly distributed bits for |counter|.
+  uint64_t Bits(uint64_t counter) const {
+    return Mix(key_ + counter * kGoldenGamma);
+  }
+  // Uniform in [0, 1).
+  double Unit(uint64_t counter) const {
+    return static_cast<double>(Bits(counter) >> 11) * 0x1.0p-53;
+  }
+  // Uniform in [-1, 1).
+  double Signed(uint64_t counter) const { return Unit(counter) * 2.0 - 1.0; }
+  // Uniform in [0, bound); 0 if |bound| is 0.
+  uint32_t Below(uint64_t counter, uint32_t bound) const {
+    return static_cast<uint32_t>(
+        ((Bits(counter) >> 32) * static_cast<uint64_t>(bound)) >> 32);
+  }
+  // True with probability |percent| / 100.
+  bool Chance(uint64_t counter, int percent) const {
+    return static_cast<int>(Below(counter, 100)) < percent;
+  }
+
+  // Batch form: element i uses counter |first| + i. Written as a plain loop
+  // over the inlined mixer so that the compiler can vectorize it.
+  void FillBits(uint64_t first, base::span<uint8_t> out) const;
+
+  // Stable counters for non-integer inputs. Doubles are keyed by their bit
+  // pattern (-0 and +0 collapse); strings by their content, with 8-bit and
+  // 16-bit representations of the same text giving the same counter; fonts
+  // by family, size, weight and style. Counters of long strings are cached
+  // per thread by string identity, so hashing the same String again is O(1).
+  static uint64_t CounterFromDouble(double value);
+  static uint64_t CounterFromString(const String& value);
+  static uint64_t CounterFromFont(const FontDescription& description);
+
+ private:
+  static constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ull;
+
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t key_;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_NOISE_H_
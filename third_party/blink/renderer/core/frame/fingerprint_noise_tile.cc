@@ -0,0 +1,132 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/frame/fingerprint_noise_tile.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/check_op.h"
+#include "base/compiler_specific.h"
+#include "base/synchronization/lock.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+namespace {
+
+// Identities rarely change within a process; a handful of tiles covers the
+// current one and whatever a few in-flight exports still use.
+constexpr wtf_size_t kMaxCachedTiles = 4;
+
+base::Lock& TileCacheLock() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(base::Lock, lock, ());
+  return lock;
+}
+
+// Most recently used first.
+Vector<scoped_refptr<const FingerprintNoiseTile>>& CachedTiles() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(
+      Vector<scoped_refptr<const FingerprintNoiseTile>>, tiles, ());
+  return tiles;
+}
+
+// Replaces the colour LSBs of |count| pixels at |pixels| with |bits|. Plain
+// loop over contiguous arrays so that it vectorizes.
+void ApplyToRun(uint8_t* pixels, const uint8_t* bits, int count) {
+  for (int i = 0; i < count; ++i) {
+    uint32_t pixel;
+    // SAFETY: the caller passes |count| 4-byte pixels and |count| bits.
+    UNSAFE_BUFFERS(memcpy(&pixel, pixels + i * 4, sizeof(pixel)));
+    const uint32_t bit = UNSAFE_BUFFERS(bits[i]);
+    // Spread bits 0-2 to the channel LSBs (bits 0, 8 and 16 little-endian);
+    // the mask is cleared for alpha == 0.
+    const uint32_t noise = (bit & 1u) | ((bit & 2u) << 7) | ((bit & 4u) << 14);
+    const uint32_t mask =
+        0x00010101u & (0u - static_cast<uint32_t>((pixel >> 24) != 0));
+    pixel = (pixel & ~mask) | (noise & mask);
+    UNSAFE_BUFFERS(memcpy(pixels + i * 4, &pixel, sizeof(pixel)));
+  }
+}
+
+}  // namespace
+
+// static
+scoped_refptr<const FingerprintNoiseTile> FingerprintNoiseTile::Get(
+    int32_t seed,
+    FingerprintNoiseDomain domain) {
+  {
+    base::AutoLock locker(TileCacheLock());
+    Vector<scoped_refptr<const FingerprintNoiseTile>>& tiles = CachedTiles();
+    for (wtf_size_t i = 0; i < tiles.size(); ++i) {
+      if (tiles[i]->seed_ == seed && tiles[i]->domain_ == domain) {
+        scoped_refptr<const FingerprintNoiseTile> tile = tiles[i];
+        tiles.EraseAt(i);
+        tiles.insert(0, tile);
+        return tile;
+      }
+    }
+  }
+  // Built outside the lock; if another thread raced us to the same tile,
+  // both are identical and the extra one is simply dropped later.
+  scoped_refptr<const FingerprintNoiseTile> tile = Create(seed, domain);
+  base::AutoLock locker(TileCacheLock());
+  Vector<scoped_refptr<const FingerprintNoiseTile>>& tiles = CachedTiles();
+  if (tiles.size() == kMaxCachedTiles) {
+    tiles.pop_back();
+  }
+  tiles.insert(0, tile);
+  return tile;
+}
+
+// static
+scoped_refptr<const FingerprintNoiseTile> FingerprintNoiseTile::Create(
+    int32_t seed,
+    FingerprintNoiseDomain domain) {
+  return base::AdoptRef(new FingerprintNoiseTile(seed, domain));
+}
+
+FingerprintNoiseTile::FingerprintNoiseTile(int32_t seed,
+                                           FingerprintNoiseDomain domain)
+    : seed_(seed), domain_(domain) {
+  // Byte i is keyed by counter i = (y << 8) | x, the same layout as Index().
+  FingerprintNoise(seed, domain).FillBits(0, bits_);
+}
+
+void FingerprintNoiseTile::ApplyToPixels(base::span<uint8_t> pixels,
+                                         size_t row_bytes,
+                                         int width,
+                                         int height,
+                                         int origin_x,
+                                         int origin_y) const {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  const size_t row_size = static_cast<size_t>(width) * 4;
+  CHECK_GE(row_bytes, row_size);
+  CHECK_GE(pixels.size(),
+           row_bytes * static_cast<size_t>(height - 1) + row_size);
+
+  for (int y = 0; y < height; ++y) {
+    uint8_t* row = pixels.subspan(static_cast<size_t>(y) * row_bytes, row_size)
+                       .data();
+    // SAFETY: Index() is always within |bits_|, and a run never crosses the
+    // end of a tile row.
+    const uint8_t* tile_row =
+        UNSAFE_BUFFERS(bits_.data() + Index(0, origin_y + y));
+    int tile_x = static_cast<int>(Index(origin_x, 0));
+    for (int x = 0; x < width;) {
+      const int run = std::min(width - x, kSize - tile_x);
+      UNSAFE_BUFFERS(ApplyToRun(row + static_cast<size_t>(x) * 4,
+                                tile_row + tile_x, run));
+      x += run;
+      tile_x = 0;
+    }
+  }
+}
+
+}  // namespace blink
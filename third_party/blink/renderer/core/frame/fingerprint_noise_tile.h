@@ -0,0 +1,91 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_NOISE_TILE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_NOISE_TILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "base/containers/span.h"
+#include "base/memory/scoped_refptr.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/thread_safe_ref_counted.h"
+
+namespace blink {
+
+// Precomputed pixel readback noise: kSize x kSize noise bytes derived from a
+// seed and a domain, repeated over absolute canvas coordinates. The byte for
+// canvas pixel (x, y) is At(x, y); its bits 0-2 are the noise bits of the
+// pixel's first three channels.
+//
+// Readbacks only look values up, so the per-pixel cost is a streaming
+// masked store over the output buffer, and the noise of a pixel depends on
+// nothing but its coordinates: overlapping reads, crops and every readback
+// path agree. Tiles are immutable once built and can be shared across
+// threads.
+class CORE_EXPORT FingerprintNoiseTile final
+    : public ThreadSafeRefCounted<FingerprintNoiseTile> {
+  USING_FAST_MALLOC(FingerprintNoiseTile);
+
+ public:
+  static constexpr int kSize = 256;
+
+  // The tile for |seed| and |domain|. The last few tiles are kept for the
+  // process, so all readbacks under one identity share a single tile.
+  static scoped_refptr<const FingerprintNoiseTile> Get(
+      int32_t seed,
+      FingerprintNoiseDomain domain);
+  // An uncached tile, for one-off keys.
+  static scoped_refptr<const FingerprintNoiseTile> Create(
+      int32_t seed,
+      FingerprintNoiseDomain domain);
+
+  FingerprintNoiseTile(const FingerprintNoiseTile&) = delete;
+  FingerprintNoiseTile& operator=(const FingerprintNoiseTile&) = delete;
+
+  uint8_t At(int x, int y) const { return bits_[Index(x, y)]; }
+
+  // |pixels| holds |height| rows of |width| 8-bit RGBA or BGRA pixels (alpha
+  // last), |row_bytes| apart, whose top-left pixel is canvas pixel
+  // (|origin_x|, |origin_y|). Each colour channel's least significant bit is
+  // replaced by the tile's bit for that pixel, which changes it with
+  // probability 1/2. Replacing rather than flipping makes the noise
+  // idempotent, so pixels that pass through several noised stages (e.g. an
+  // exported image drawn back and read again) never get their true low bits
+  // back. Fully transparent pixels are left alone so that blank areas stay
+  // blank.
+  void ApplyToPixels(base::span<uint8_t> pixels,
+                     size_t row_bytes,
+                     int width,
+                     int height,
+                     int origin_x,
+                     int origin_y) const;
+
+ private:
+  friend class ThreadSafeRefCounted<FingerprintNoiseTile>;
+
+  FingerprintNoiseTile(int32_t seed, FingerprintNoiseDomain domain);
+  ~FingerprintNoiseTile() = default;
+
+  static size_t Index(int x, int y) {
+    // Two's complement wrap-around keeps negative coordinates on the same
+    // period as positive ones.
+    return (static_cast<size_t>(static_cast<uint32_t>(y) & (kSize - 1))
+            << 8) |
+           (static_cast<uint32_t>(x) & (kSize - 1));
+  }
+
+  const int32_t seed_;
+  const FingerprintNoiseDomain domain_;
+  std::array<uint8_t, kSize * kSize> bits_;
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_NOISE_TILE_H_
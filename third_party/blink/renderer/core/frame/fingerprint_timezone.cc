@@ -0,0 +1,183 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/frame/fingerprint_timezone.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+#include "third_party/blink/public/platform/task_type.h"
+#include "third_party/blink/public/web/web_fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/workers/worker_or_worklet_global_scope.h"
+#include "third_party/blink/renderer/core/workers/worker_thread.h"
+#include "third_party/blink/renderer/platform/scheduler/public/main_thread.h"
+#include "third_party/blink/renderer/platform/scheduler/public/main_thread_scheduler.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+#include "third_party/icu/source/i18n/unicode/timezone.h"
+#include "v8/include/v8.h"
+
+namespace blink {
+
+namespace {
+
+base::Lock& ApplyLock() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(base::Lock, lock, ());
+  return lock;
+}
+
+// Validated prototypes handed out by CreateIcuTimeZone(), keyed by zone id.
+// Unknown ids are cached as nullptr.
+using ZoneCacheMap = std::map<std::string, std::unique_ptr<icu::TimeZone>>;
+
+ZoneCacheMap& ZoneCache() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ZoneCacheMap, cache, ());
+  return cache;
+}
+
+base::Lock& ZoneCacheLock() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(base::Lock, lock, ());
+  return lock;
+}
+
+// The zone currently applied to libc and ICU; empty until the first Apply().
+std::string& AppliedZoneId() {
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(std::string, zone_id, ());
+  return zone_id;
+}
+
+// True once ApplyAtStartup() has handed the zone to V8 as a flag; later
+// changes have to be announced to live isolates instead.
+bool g_v8_configured = false;
+
+// True once ApplyAtStartup() has run. A renderer launched without its
+// identity applies no zone at startup, so its first zone arrives after V8
+// is up and has to be announced as well.
+bool g_startup_done = false;
+
+void SetProcessTimezoneEnv(const std::string& zone_id) {
+#if BUILDFLAG(IS_WIN)
+  // Windows CRT 只有在 _tzset() 之后才会刷新时区
+  _putenv_s("TZ", zone_id.c_str());
+  _tzset();
+#else
+  setenv("TZ", zone_id.c_str(), 1);
+  tzset();
+#endif
+}
+
+// Same notifications as TimeZoneController sends on a host zone change: ICU
+// already has the new default, isolates only drop their date caches.
+void NotifyTimezoneChangeToV8(v8::Isolate* isolate) {
+  DCHECK(isolate);
+  isolate->DateTimeConfigurationChangeNotification();
+}
+
+void NotifyTimezoneChangeOnWorkerThread(WorkerThread* worker_thread) {
+  DCHECK(worker_thread->IsCurrentThread());
+  NotifyTimezoneChangeToV8(worker_thread->GlobalScope()->GetIsolate());
+}
+
+// Zone changes after startup come from FingerprintConfig::Publish(), which
+// runs on the main thread.
+void NotifyTimezoneChange() {
+  DCHECK(IsMainThread());
+  Thread::MainThread()
+      ->Scheduler()
+      ->ToMainThreadScheduler()
+      ->ForEachMainThreadIsolate(&NotifyTimezoneChangeToV8);
+  WorkerThread::CallOnAllWorkerThreads(&NotifyTimezoneChangeOnWorkerThread,
+                                       TaskType::kInternalDefault);
+}
+
+}  // namespace
+
+// static
+void FingerprintTimezone::ApplyAtStartup() {
+  // Instance() loads the config and applies its zone on first use.
+  const FingerprintConfig& config = FingerprintConfig::Instance();
+  Apply(config);
+
+  base::AutoLock locker(ApplyLock());
+  g_startup_done = true;
+  if (g_v8_configured || AppliedZoneId().empty()) {
+    return;
+  }
+  std::string v8_flag = "--timezone=" + AppliedZoneId();
+  v8::V8::SetFlagsFromString(v8_flag.c_str(), v8_flag.size());
+  g_v8_configured = true;
+  LOG(ERROR) << ">>> [FINGERPRINT] RENDERER: V8 Flag set: " << v8_flag;
+}
+
+// static
+void FingerprintTimezone::Apply(const FingerprintConfig& config) {
+  if (!config.timezone.spoofing_enabled || config.timezone.zone_id.empty()) {
+    return;
+  }
+  const std::string zone_id = config.timezone.zone_id.Utf8();
+
+  base::AutoLock locker(ApplyLock());
+  if (zone_id == AppliedZoneId()) {
+    return;
+  }
+  TRACE_EVENT1("blink", "FingerprintTimezone::Apply", "zone_id", zone_id);
+
+  std::unique_ptr<icu::TimeZone> zone = CreateIcuTimeZone(zone_id);
+  if (!zone) {
+    LOG(ERROR) << ">>> [FINGERPRINT] ERROR: Invalid Timezone ID: " << zone_id;
+    return;
+  }
+
+  const bool first_apply = AppliedZoneId().empty();
+  SetProcessTimezoneEnv(zone_id);
+  icu::TimeZone::adoptDefault(zone.release());
+  AppliedZoneId() = zone_id;
+
+  if (!first_apply || g_startup_done) {
+    // A later identity (e.g. a late-bound spare renderer) changed the zone;
+    // isolates may already have cached the previous one.
+    NotifyTimezoneChange();
+  }
+  LOG(ERROR) << ">>> [FINGERPRINT] Timezone applied: " << zone_id;
+}
+
+// static
+String FingerprintTimezone::ResolveHostZoneId(const String& host_zone_id) {
+  const FingerprintConfig& config = FingerprintConfig::Instance();
+  if (!config.timezone.spoofing_enabled || config.timezone.zone_id.empty()) {
+    return host_zone_id;
+  }
+  return config.timezone.zone_id;
+}
+
+// static
+std::unique_ptr<icu::TimeZone> FingerprintTimezone::CreateIcuTimeZone(
+    const std::string& zone_id) {
+  base::AutoLock locker(ZoneCacheLock());
+  auto [it, inserted] = ZoneCache().try_emplace(zone_id);
+  if (inserted) {
+    std::unique_ptr<icu::TimeZone> zone(icu::TimeZone::createTimeZone(
+        icu::UnicodeString(zone_id.c_str(), -1, US_INV)));
+    if (zone && *zone != icu::TimeZone::getUnknown()) {
+      it->second = std::move(zone);
+    }
+  }
+  return it->second ? base::WrapUnique(it->second->clone()) : nullptr;
+}
+
+void ApplyFingerprintTimezoneAtStartup() {
+  FingerprintTimezone::ApplyAtStartup();
+}
+
+}  // namespace blink
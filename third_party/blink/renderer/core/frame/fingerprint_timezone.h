@@ -0,0 +1,51 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_TIMEZONE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_TIMEZONE_H_
+
+#include <memory>
+#include <string>
+
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/icu/source/i18n/unicode/timezone.h"
+
+namespace blink {
+
+class FingerprintConfig;
+
+// Applies the fingerprint timezone to libc (TZ), ICU's default zone and V8
+// once per process. Frame and worker creation never touch it; the zone is
+// only re-applied when a snapshot with a different zone is published.
+class CORE_EXPORT FingerprintTimezone {
+  STATIC_ONLY(FingerprintTimezone);
+
+ public:
+  // Renderer startup, before V8 is initialized: loads the config, applies its
+  // zone and passes it to V8 as --timezone.
+  static void ApplyAtStartup();
+
+  // Applies |config|'s zone if it differs from the one in effect. Once V8
+  // isolates exist, main-thread and worker isolates are told to drop their
+  // cached date configuration.
+  static void Apply(const FingerprintConfig& config);
+
+  // Returns the zone pages should treat as the host zone: the identity's zone
+  // while timezone spoofing is on, |host_zone_id| otherwise. Used by
+  // TimeZoneController so that OS zone changes and the end of a DevTools
+  // override never expose the real zone.
+  static String ResolveHostZoneId(const String& host_zone_id);
+
+  // Returns a new ICU zone for |zone_id|, cloned from a per-zone cache so the
+  // zoneinfo lookup happens once per zone and process. Returns nullptr for
+  // unknown ids. Thread-safe.
+  static std::unique_ptr<icu::TimeZone> CreateIcuTimeZone(
+      const std::string& zone_id);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_TIMEZONE_H_
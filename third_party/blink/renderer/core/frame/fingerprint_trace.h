@@ -0,0 +1,36 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_TRACE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_TRACE_H_
+
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+
+// Scoped trace slice around one spoofing hook, used to measure what the
+// fingerprint patches cost per call.
+//
+// Slices are named "Fingerprint::<hook>" and go to a disabled-by-default
+// category, so a hook costs one category check unless that category is
+// recorded. |spoofed| is recorded as an argument: the same trace, or a trace
+// of the same page with the identity's switches turned off, gives the
+// baseline, and the per-hook overhead is the difference of the mean slice
+// durations. Collect with e.g.
+//   --trace-startup=disabled-by-default-blink.debug
+//   --trace-startup-format=json --trace-startup-file=fingerprint_trace.json
+// and aggregate by name and args.spoofed in trace processor.
+#define FINGERPRINT_TRACE_HOOK(hook, spoofed)                         \
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("blink.debug"),               \
+               "Fingerprint::" hook, "spoofed", static_cast<bool>(spoofed))
+
+// Same, for hooks whose cost is only visible across tasks (e.g. an offline
+// audio render between startRendering() and the completion event).
+#define FINGERPRINT_TRACE_HOOK_BEGIN(hook, id, spoofed)                       \
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(TRACE_DISABLED_BY_DEFAULT("blink.debug"), \
+                                    "Fingerprint::" hook, TRACE_ID_LOCAL(id), \
+                                    "spoofed", static_cast<bool>(spoofed))
+#define FINGERPRINT_TRACE_HOOK_END(hook, id)                                \
+  TRACE_EVENT_NESTABLE_ASYNC_END0(TRACE_DISABLED_BY_DEFAULT("blink.debug"), \
+                                  "Fingerprint::" hook, TRACE_ID_LOCAL(id))
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_FRAME_FINGERPRINT_TRACE_H_
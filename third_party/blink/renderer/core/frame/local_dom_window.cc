@@ -25,7 +25,6 @@
  */
 
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
-#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
 #include "base/functional/bind.h"
 #include <memory>
 #include <optional>
@@ -271,22 +270,7 @@ LocalDOMWindow::LocalDOMWindow(LocalFrame& frame, WindowAgent* agent)
       token_(frame.GetLocalFrameToken()),
       network_state_observer_(MakeGarbageCollected<NetworkStateObserver>(this)),
       closewatcher_stack_(
-          MakeGarbageCollected<CloseWatcher::WatcherStack>(this)) {
-            // ================= [FINGERPRINT HARDCODE START] =================
-            // 1. ȷñִ
-            FingerprintConfig::Instance().EnforceTimezone();
-
-            // 2. ӻ֤ F12 ̨һϢ
-            // ֻҪҳ F12 Ϣ֤ C++ Чˣ
-            AddConsoleMessage(MakeGarbageCollected<ConsoleMessage>(
-                mojom::blink::ConsoleMessageSource::kOther,
-                mojom::blink::ConsoleMessageLevel::kWarning,
-                "!!! FINGERPRINT HARDCODE ACTIVE: America/New_York !!!"));
-
-            // 3. ӡ־
-            LOG(ERROR) << ">>> [FINGERPRINT] LocalDOMWindow Constructed";
-            // ================= [FINGERPRINT HARDCODE END] =================
-            }
+          MakeGarbageCollected<CloseWatcher::WatcherStack>(this)) {}
 
 void LocalDOMWindow::BindContentSecurityPolicy() {
   DCHECK(!GetContentSecurityPolicy()->IsBound());
@@ -7,7 +7,8 @@ namespace blink {
 
 // [Modified] Fingerprint Spoofing
 float NavigatorDeviceMemory::deviceMemory() const {
-  blink::FingerprintConfig* config = blink::FingerprintConfig::GetInstance();
+  const blink::FingerprintConfig* config =
+      blink::FingerprintConfig::GetInstance();
   if (config && config->ua.enabled) {
     return config->GetDeviceMemory();
   }
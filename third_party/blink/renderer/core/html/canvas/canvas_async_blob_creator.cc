@@ -4,9 +4,17 @@
 
 #include "third_party/blink/renderer/core/html/canvas/canvas_async_blob_creator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+#include "base/containers/span.h"
 #include "base/location.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 #include "third_party/blink/public/platform/platform.h"
@@ -16,17 +24,24 @@
 #include "third_party/blink/renderer/core/dom/dom_exception.h"
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 #include "third_party/blink/renderer/core/fileapi/blob.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_canvas_readback.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_encoded_output_cache.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/html/canvas/canvas_rendering_context.h"
 #include "third_party/blink/renderer/platform/graphics/image_data_buffer.h"
 #include "third_party/blink/renderer/platform/graphics/skia/skia_utils.h"
 #include "third_party/blink/renderer/platform/graphics/unaccelerated_static_bitmap_image.h"
+#include "third_party/blink/renderer/platform/heap/collection_support/heap_hash_map.h"
 #include "third_party/blink/renderer/platform/heap/garbage_collected.h"
+#include "third_party/blink/renderer/platform/heap/member.h"
 #include "third_party/blink/renderer/platform/image-encoders/image_encoder_utils.h"
 #include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
 #include "third_party/blink/renderer/platform/scheduler/public/worker_pool.h"
+#include "third_party/blink/renderer/platform/supplementable.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_copier_base.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_copier_skia.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_copier_std.h"
@@ -34,8 +49,10 @@
 #include "third_party/blink/renderer/platform/wtf/functional.h"
 #include "third_party/blink/renderer/platform/wtf/text/base64.h"
 #include "third_party/blink/renderer/platform/wtf/text/strcat.h"
+#include "third_party/blink/renderer/platform/wtf/thread_safe_ref_counted.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/encode/SkPngRustEncoder.h"
+#include "third_party/zlib/zlib.h"
 
 namespace blink {
 
@@ -68,6 +85,306 @@ const double kIdleTaskCompleteTimeoutDelayMs = 5700.0;
 const double kIdleTaskCompleteTimeoutDelayMs = 9000.0;
 #endif
 
+// Images with fewer pixels are encoded in a single worker task; splitting
+// them is not worth the extra tasks.
+constexpr int kMinStripedPngPixels = 512 * 512;
+constexpr int kMinRowsPerStripe = 16;
+constexpr int kMaxPngStripes = 32;
+
+// Fingerprint defense: add a tiny, nondestructive variation to the encoded
+// output bytes so hash-based canvas fingerprinting becomes unstable. Only for
+// PNG/JPEG: trailing bytes after IEND / EOI are widely tolerated by decoders
+// and do not affect rendering. Runs once per export, in
+// CreateBlobAndReturnResult() on the creator's thread, after whichever
+// encoding path finished. |seed| is the identity's seed if it enables canvas
+// noise, captured with the pixel noise when the creator was made (see
+// EncodingNoiseSeeds), so that a publish mid-export cannot split the two.
+void AppendEncodingNoise(std::optional<int32_t> seed,
+                         ImageEncodingMimeType mime_type,
+                         int width,
+                         int height,
+                         Vector<unsigned char>& encoded_image) {
+  FINGERPRINT_TRACE_HOOK("ToBlob", seed.has_value());
+  if (!seed || (mime_type != kMimeTypePng && mime_type != kMimeTypeJpeg) ||
+      encoded_image.empty()) {
+    return;
+  }
+  // [修复] 使用 global_seed 和图像尺寸生成确定性尾字节
+  // 关键: 改变 seed → 改变添加的字节数量 → 改变 blob size
+  const uint64_t size_counter =
+      (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) |
+      static_cast<uint32_t>(height);
+  unsigned combined = static_cast<unsigned>(
+      FingerprintNoise(*seed, FingerprintNoiseDomain::kCanvasEncoding)
+          .Bits(size_counter) >>
+      32);
+  // 添加 1-4 个尾字节，数量由 seed 决定
+  unsigned extra_bytes = (combined % 4u) + 1u;
+  for (unsigned i = 0; i < extra_bytes; ++i) {
+    unsigned byte_val = (combined >> (i * 8)) & 0xFFu;
+    encoded_image.push_back(static_cast<unsigned char>(byte_val));
+  }
+}
+
+// The trailer seeds of the blob creators of one execution context, recorded
+// from the same identity snapshot as the creator's pixel noise. Only creators
+// whose identity enables canvas noise have an entry, so nothing is allocated
+// while the defense is off. Creators are held weakly: an export that fails
+// or is abandoned drops its entry with the creator.
+class EncodingNoiseSeeds final : public GarbageCollected<EncodingNoiseSeeds>,
+                                 public Supplement<ExecutionContext> {
+ public:
+  static const char kSupplementName[];
+
+  static void Set(ExecutionContext& context,
+                  const CanvasAsyncBlobCreator& creator,
+                  int32_t seed) {
+    auto* seeds =
+        Supplement<ExecutionContext>::From<EncodingNoiseSeeds>(context);
+    if (!seeds) {
+      seeds = MakeGarbageCollected<EncodingNoiseSeeds>(context);
+      ProvideTo(context, seeds);
+    }
+    seeds->seeds_.Set(&creator, seed);
+  }
+
+  static std::optional<int32_t> Take(ExecutionContext* context,
+                                     const CanvasAsyncBlobCreator& creator) {
+    auto* seeds =
+        context
+            ? Supplement<ExecutionContext>::From<EncodingNoiseSeeds>(context)
+            : nullptr;
+    if (!seeds) {
+      return std::nullopt;
+    }
+    auto it = seeds->seeds_.find(&creator);
+    if (it == seeds->seeds_.end()) {
+      return std::nullopt;
+    }
+    const int32_t seed = it->value;
+    seeds->seeds_.erase(it);
+    return seed;
+  }
+
+  explicit EncodingNoiseSeeds(ExecutionContext& context)
+      : Supplement<ExecutionContext>(context) {}
+
+  void Trace(Visitor* visitor) const override {
+    visitor->Trace(seeds_);
+    Supplement<ExecutionContext>::Trace(visitor);
+  }
+
+ private:
+  HeapHashMap<WeakMember<const CanvasAsyncBlobCreator>, int32_t> seeds_;
+};
+
+// static
+const char EncodingNoiseSeeds::kSupplementName[] = "EncodingNoiseSeeds";
+
+void AppendBigEndian32(Vector<unsigned char>& out, uint32_t value) {
+  out.push_back(static_cast<unsigned char>(value >> 24));
+  out.push_back(static_cast<unsigned char>(value >> 16));
+  out.push_back(static_cast<unsigned char>(value >> 8));
+  out.push_back(static_cast<unsigned char>(value));
+}
+
+// Appends a PNG chunk whose data is the concatenation of |parts|.
+void AppendPngChunk(Vector<unsigned char>& out,
+                    const char (&type)[5],
+                    std::initializer_list<base::span<const uint8_t>> parts) {
+  size_t length = 0;
+  for (const auto& part : parts) {
+    length += part.size();
+  }
+  AppendBigEndian32(out, base::checked_cast<uint32_t>(length));
+  const auto type_bytes = base::byte_span_from_cstring(type);
+  out.AppendSpan(type_bytes);
+  uLong crc = crc32(0, type_bytes.data(), type_bytes.size());
+  for (const auto& part : parts) {
+    out.AppendSpan(part);
+    crc = crc32(crc, part.data(), base::checked_cast<uInt>(part.size()));
+  }
+  AppendBigEndian32(out, static_cast<uint32_t>(crc));
+}
+
+// Parallel PNG encoder for toBlob() / convertToBlob().
+//
+// The image is cut into horizontal stripes that are converted, filtered and
+// deflated independently on the worker pool. Every stripe but the last ends
+// with a sync flush, which byte-aligns it without setting BFINAL, so the
+// stripes concatenate into one valid deflate stream; their Adler-32s are
+// combined for the zlib trailer, and each stripe becomes one IDAT chunk.
+// Whichever stripe finishes last assembles the file, so the result is ready
+// as soon as the final stripe lands.
+class StripedPngEncoder final
+    : public ThreadSafeRefCounted<StripedPngEncoder> {
+ public:
+  using ResultCallback =
+      CrossThreadOnceFunction<void(std::optional<Vector<unsigned char>>)>;
+
+  // Only 8-bit sRGB sources are striped; the output is 8-bit RGBA with no
+  // colour profile, which is what the regular encoder writes for them.
+  static bool CanEncode(const SkPixmap& src) {
+    return (src.colorType() == kRGBA_8888_SkColorType ||
+            src.colorType() == kBGRA_8888_SkColorType) &&
+           (!src.colorSpace() || src.colorSpace()->isSRGB()) &&
+           static_cast<int64_t>(src.width()) * src.height() >=
+               kMinStripedPngPixels;
+  }
+
+  // |image| keeps |src|'s pixels alive. |callback| runs on a worker thread
+  // with the encoded file, or nullopt on failure.
+  static void Start(sk_sp<SkImage> image,
+                    const SkPixmap& src,
+                    ResultCallback callback) {
+    DCHECK(CanEncode(src));
+    scoped_refptr<StripedPngEncoder> encoder = base::AdoptRef(
+        new StripedPngEncoder(std::move(image), src, std::move(callback)));
+    for (wtf_size_t i = 0; i < encoder->stripes_.size(); ++i) {
+      worker_pool::PostTask(
+          FROM_HERE, CrossThreadBindOnce(&StripedPngEncoder::EncodeStripe,
+                                         encoder, i));
+    }
+  }
+
+ private:
+  friend class ThreadSafeRefCounted<StripedPngEncoder>;
+
+  struct Stripe {
+    Vector<unsigned char> deflated;
+    uLong adler = 0;
+    size_t filtered_size = 0;
+    bool ok = false;
+  };
+
+  StripedPngEncoder(sk_sp<SkImage> image,
+                    const SkPixmap& src,
+                    ResultCallback callback)
+      : image_(std::move(image)),
+        src_(src),
+        rows_per_stripe_(std::max(
+            kMinRowsPerStripe,
+            (src.height() + kMaxPngStripes - 1) / kMaxPngStripes)),
+        callback_(std::move(callback)) {
+    stripes_.resize(
+        (src_.height() + rows_per_stripe_ - 1) / rows_per_stripe_);
+    remaining_.store(stripes_.size(), std::memory_order_relaxed);
+  }
+  ~StripedPngEncoder() = default;
+
+  void EncodeStripe(wtf_size_t index) {
+    stripes_[index].ok = EncodeStripeInternal(index, stripes_[index]);
+    // The last stripe to finish sees every other stripe's result.
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Assemble();
+    }
+  }
+
+  bool EncodeStripeInternal(wtf_size_t index, Stripe& stripe) const {
+    const int top = static_cast<int>(index) * rows_per_stripe_;
+    const int rows = std::min(rows_per_stripe_, src_.height() - top);
+    const size_t row_size = static_cast<size_t>(src_.width()) * 4;
+
+    SkPixmap stripe_src;
+    if (!src_.extractSubset(&stripe_src,
+                            SkIRect::MakeXYWH(0, top, src_.width(), rows))) {
+      return false;
+    }
+    std::vector<uint8_t> pixels(row_size * rows);
+    if (!stripe_src.readPixels(
+            SkImageInfo::Make(src_.width(), rows, kRGBA_8888_SkColorType,
+                              kUnpremul_SkAlphaType),
+            pixels.data(), row_size)) {
+      return false;
+    }
+
+    // Every scanline uses the Sub filter, which only looks at its own row,
+    // so stripes need nothing from their neighbours.
+    std::vector<uint8_t> filtered((row_size + 1) * rows);
+    for (int y = 0; y < rows; ++y) {
+      auto in = base::span(pixels).subspan(y * row_size, row_size);
+      auto out = base::span(filtered).subspan(y * (row_size + 1), row_size + 1);
+      out[0] = 1;  // Sub.
+      for (size_t i = 0; i < row_size; ++i) {
+        out[i + 1] = static_cast<uint8_t>(in[i] - (i >= 4 ? in[i - 4] : 0));
+      }
+    }
+    stripe.filtered_size = filtered.size();
+    stripe.adler = adler32(adler32(0, Z_NULL, 0), filtered.data(),
+                           base::checked_cast<uInt>(filtered.size()));
+
+    z_stream stream = {};
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS,
+                     /*memLevel=*/8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      return false;
+    }
+    const bool last = index + 1 == stripes_.size();
+    // deflateBound() does not cover the 5-byte sync flush marker.
+    stripe.deflated.resize(
+        base::checked_cast<wtf_size_t>(deflateBound(&stream, filtered.size())) +
+        16);
+    stream.next_in = filtered.data();
+    stream.avail_in = base::checked_cast<uInt>(filtered.size());
+    stream.next_out = stripe.deflated.data();
+    stream.avail_out = stripe.deflated.size();
+    const int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool ok = last ? result == Z_STREAM_END
+                         : result == Z_OK && stream.avail_in == 0 &&
+                               stream.avail_out > 0;
+    stripe.deflated.Shrink(static_cast<wtf_size_t>(stream.total_out));
+    deflateEnd(&stream);
+    return ok;
+  }
+
+  void Assemble() {
+    std::optional<Vector<unsigned char>> png;
+    if (std::all_of(stripes_.begin(), stripes_.end(),
+                    [](const Stripe& stripe) { return stripe.ok; })) {
+      png.emplace();
+      static constexpr uint8_t kSignature[] = {0x89, 'P',  'N',  'G',
+                                               '\r',  '\n', 0x1A, '\n'};
+      png->AppendSpan(base::span(kSignature));
+
+      // Bit depth 8, colour type 6 (RGBA), deflate, adaptive filtering,
+      // no interlace.
+      static constexpr uint8_t kHeaderTail[] = {8, 6, 0, 0, 0};
+      Vector<unsigned char> header;
+      AppendBigEndian32(header, static_cast<uint32_t>(src_.width()));
+      AppendBigEndian32(header, static_cast<uint32_t>(src_.height()));
+      header.AppendSpan(base::span(kHeaderTail));
+      AppendPngChunk(*png, "IHDR", {header});
+
+      // CMF/FLG for deflate with a 32K window, no preset dictionary.
+      static constexpr uint8_t kZlibHeader[] = {0x78, 0x01};
+      uLong adler = adler32(0, Z_NULL, 0);
+      for (wtf_size_t i = 0; i < stripes_.size(); ++i) {
+        const Stripe& stripe = stripes_[i];
+        adler = adler32_combine(adler, stripe.adler,
+                                static_cast<z_off_t>(stripe.filtered_size));
+        Vector<unsigned char> trailer;
+        if (i + 1 == stripes_.size()) {
+          AppendBigEndian32(trailer, static_cast<uint32_t>(adler));
+        }
+        AppendPngChunk(*png, "IDAT",
+                       {i == 0 ? base::span<const uint8_t>(kZlibHeader)
+                               : base::span<const uint8_t>(),
+                        stripe.deflated, trailer});
+      }
+      AppendPngChunk(*png, "IEND", {});
+    }
+    stripes_.clear();
+    image_ = nullptr;
+    std::move(callback_).Run(std::move(png));
+  }
+
+  sk_sp<SkImage> image_;
+  const SkPixmap src_;
+  const int rows_per_stripe_;
+  Vector<Stripe> stripes_;
+  std::atomic<wtf_size_t> remaining_;
+  ResultCallback callback_;
+};
+
 bool IsCreateBlobDeadlineNearOrPassed(base::TimeTicks deadline) {
   return base::TimeTicks::Now() >= deadline - kCreateBlobSlackBeforeDeadline;
 }
@@ -197,6 +514,18 @@ CanvasAsyncBlobCreator::CanvasAsyncBlobCreator(
       skia_image_->readPixels(info, pixel, info.minRowBytes(), 0, 0);
     }
 
+    // [Canvas 指纹防御] 与 toDataURL() 相同的像素噪声。创建者运行在拥有画布
+    // 的线程上（主线程或 Worker），之后的各条编码路径只看到加噪后的像素。
+    // 尾字节用同一份身份快照决定，编码期间发布新配置也不会让两者分属不同身份。
+    const FingerprintConfig& identity = FingerprintConfig::Instance();
+    if (identity.GetCanvasMeasureTextNoiseEnable()) {
+      EncodingNoiseSeeds::Set(*context, *this, identity.GetGlobalSeed());
+    }
+    skia_image_ =
+        FingerprintCanvasReadback(FingerprintCanvasReadback::Mode::kExport,
+                                  identity)
+            .ApplyToImage(std::move(skia_image_));
+
     if (skia_image_->peekPixels(&src_data_)) {
       static_bitmap_image_loaded_ = true;
 
@@ -255,10 +584,12 @@ bool CanvasAsyncBlobCreator::EncodeImage(
 // Before the blob itself is created, we need to encode the image.
 // This happens in one of the following ways:
 //
-//  1.   If progressive encoding is supported, then we use idle tasks
+//  1.   If idle encoding is enforced for testing, then we use idle tasks
 //       to gradually encode the image. This happens entirely on
 //       the current thread.
-//  2.   If progressive encoding is NOT supported, and
+//  2.   Otherwise, for large 8-bit sRGB PNGs, stripes of the image are
+//       encoded in parallel on the worker pool (see StripedPngEncoder).
+//  3.   Otherwise, if
 //    a. the current thread is the main thread, then we use a worker thread to
 //       encode the image, otherwise:
 //    b. if the current thread is not the main thread, then we encode the image
@@ -270,9 +601,13 @@ bool CanvasAsyncBlobCreator::EncodeImage(
 //  - For the progressive encoding case (1), stored to members on `this`,
 //    which are then accessed from the various encoding stages. (All from the
 //    same thread).
-//  - For the off-thread case (2a), sent to that thread via CrossThreadBindOnce.
-//  - For the in-thread case (2b), not stored anywhere, because encoding happens
+//  - For the striped (2) and off-thread (3a) cases, sent to the worker pool
+//    via CrossThreadBindOnce.
+//  - For the in-thread case (3b), not stored anywhere, because encoding happens
 //    within this function.
+//
+// Every successful path ends in CreateBlobAndReturnResult() on this thread,
+// which appends the fingerprint trailer (AppendEncodingNoise).
 void CanvasAsyncBlobCreator::ScheduleAsyncBlobCreation(const double& quality) {
   if (!static_bitmap_image_loaded_) {
     context_->GetTaskRunner(TaskType::kCanvasBlobSerialization)
@@ -281,23 +616,53 @@ void CanvasAsyncBlobCreator::ScheduleAsyncBlobCreation(const double& quality) {
                             WrapPersistent(this)));
     return;
   }
-  // Webp encoder does not support progressive encoding. We also don't use idle
-  // encoding for web tests, since the idle task start and completition
-  // deadlines (6.7s or 13s) bypass the web test running deadline (6s)
-  // and result in timeouts on different tests. We use
-  // enforce_idle_encoding_for_test_ to test idle encoding in unit tests.
-  // We also don't use idle tasks in workers because the short idle periods are
-  // not implemented, so the idle task can take a long time even when the thread
-  // is not busy.
-  bool use_idle_encoding =
-      IsMainThread() && (mime_type_ != kMimeTypeWebp) &&
-      (enforce_idle_encoding_for_test_ ||
-       !RuntimeEnabledFeatures::NoIdleEncodingForWebTestsEnabled());
+  // Idle encoding runs one row per idle task on the main thread, and waits up
+  // to kIdleTaskCompleteTimeoutDelayMs before forcing the rest, which stalls
+  // pages that export large canvases repeatedly. It is only kept for unit
+  // tests (enforce_idle_encoding_for_test_); the worker pool is used instead.
+  // Webp encoder does not support progressive encoding, and idle tasks are
+  // not used in workers because short idle periods are not implemented there.
+  bool use_idle_encoding = IsMainThread() && (mime_type_ != kMimeTypeWebp) &&
+                           enforce_idle_encoding_for_test_;
+
+  if (!use_idle_encoding && mime_type_ == kMimeTypePng &&
+      StripedPngEncoder::CanEncode(src_data_)) {
+    // Striped case, see (2) in function comment.
+    scoped_refptr<base::SingleThreadTaskRunner> reply_task_runner =
+        IsMainThread()
+            ? parent_frame_task_runner_
+            : context_->GetTaskRunner(TaskType::kCanvasBlobSerialization);
+    StripedPngEncoder::Start(
+        skia_image_, src_data_,
+        CrossThreadBindOnce(
+            [](CrossThreadHandle<CanvasAsyncBlobCreator> cross_thread_handle,
+               scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+               std::optional<Vector<unsigned char>> encoded_image) {
+              if (!encoded_image) {
+                PostCrossThreadTask(
+                    *task_runner, FROM_HERE,
+                    CrossThreadBindOnce(
+                        &CanvasAsyncBlobCreator::CreateNullAndReturnResult,
+                        MakeUnwrappingCrossThreadHandle(
+                            std::move(cross_thread_handle))));
+                return;
+              }
+              PostCrossThreadTask(
+                  *task_runner, FROM_HERE,
+                  CrossThreadBindOnce(
+                      &CanvasAsyncBlobCreator::CreateBlobAndReturnResult,
+                      MakeUnwrappingCrossThreadHandle(
+                          std::move(cross_thread_handle)),
+                      std::move(*encoded_image)));
+            },
+            MakeCrossThreadHandle(this), std::move(reply_task_runner)));
+    return;
+  }
 
   if (!use_idle_encoding) {
     if (!IsMainThread()) {
       DCHECK(function_type_ == kOffscreenCanvasConvertToBlobPromise);
-      // In-thread case, see (2b) in function comment.
+      // In-thread case, see (3b) in function comment.
       //
       // When OffscreenCanvas.convertToBlob() occurs on worker thread,
       // we do not need to use background task runner to reduce load on main.
@@ -320,7 +685,7 @@ void CanvasAsyncBlobCreator::ScheduleAsyncBlobCreation(const double& quality) {
                        WrapPersistent(this), std::move(encoded_image)));
 
     } else {
-      // Off-thread case, see (2a) in function comment.
+      // Off-thread case, see (3a) in function comment.
 
       worker_pool::PostTask(
           FROM_HERE, CrossThreadBindOnce(
@@ -434,30 +799,13 @@ void CanvasAsyncBlobCreator::CreateBlobAndReturnResult(
     Vector<unsigned char> encoded_image) {
   RecordIdleTaskStatusHistogram(idle_task_status_);
 
-  // Fingerprint defense: add a tiny, nondestructive per-call variation to the
-  // encoded output bytes so hash-based canvas fingerprinting becomes unstable.
-  // We only do this for PNG/JPEG. Trailing bytes are widely tolerated by
-  // decoders (after IEND / EOI) and should not affect rendering.
-  if (blink::FingerprintConfig::Instance().GetCanvasMeasureTextNoiseEnable() &&
-      (mime_type_ == kMimeTypePng || mime_type_ == kMimeTypeJpeg) &&
-      !encoded_image.empty()) {
-    // [修复] 使用 global_seed 和图像尺寸生成确定性尾字节
-    // 关键: 改变 seed → 改变添加的字节数量 → 改变 blob size
-    int seed = blink::FingerprintConfig::Instance().GetGlobalSeed();
-    unsigned combined =
-        (static_cast<unsigned>(seed) ^
-         static_cast<unsigned>(image_->width() * 31 + image_->height())) *
-        2654435761u;
-    // 添加 1-4 个尾字节，数量由 seed 决定
-    unsigned extra_bytes = (combined % 4u) + 1u;
-    for (unsigned i = 0; i < extra_bytes; ++i) {
-      unsigned byte_val = (combined >> (i * 8)) & 0xFFu;
-      encoded_image.push_back(static_cast<unsigned char>(byte_val));
-    }
-  }
-
+  AppendEncodingNoise(EncodingNoiseSeeds::Take(context_.Get(), *this),
+                      mime_type_, image_->width(), image_->height(),
+                      encoded_image);
   Blob* result_blob =
       Blob::Create(encoded_image, ImageEncoderUtils::MimeTypeName(mime_type_));
+  FingerprintEncodedOutputCache::DidCreateBlob(context_.Get(), *this,
+                                               *result_blob);
   if (function_type_ == kHTMLCanvasToBlobCallback) {
     context_->GetTaskRunner(TaskType::kCanvasBlobSerialization)
         ->PostTask(FROM_HERE,
@@ -31,6 +31,7 @@
 
 #include <limits>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "base/base64.h"
@@ -71,7 +72,10 @@
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/fileapi/file.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_canvas_readback.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_encoded_output_cache.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/frame/local_frame_client.h"
@@ -697,6 +701,7 @@ void HTMLCanvasElement::DidDraw(const SkIRect& rect) {
   if (rect.isEmpty()) {
     return;
   }
+  FingerprintEncodedOutputCache::Invalidate(*this);
 
   // To avoid issuing invalidations multiple times, we can check |dirty_rect_|
   // and only issue invalidations the first time it becomes non-empty.
@@ -836,6 +841,7 @@ void HTMLCanvasElement::DoDeferredPaintInvalidation() {
 
 void HTMLCanvasElement::OnWidthOrHeightAssigned() {
   dirty_rect_ = gfx::Rect();
+  FingerprintEncodedOutputCache::Invalidate(*this);
 
   unsigned w = 0;
   AtomicString value = FastGetAttribute(html_names::kWidthAttr);
@@ -1297,83 +1303,48 @@ String HTMLCanvasElement::ToDataURLInternal(
       ImageEncoderUtils::ToEncodingMimeType(
           mime_type, ImageEncoderUtils::kEncodeReasonToDataURL);
 
+  // [Canvas 指纹防御] 内容未变时直接返回上次的编码结果：省去快照、回读、
+  // 噪声和编码，并保证同一内容逐字节一致。只缓存 2D 画布，其内容变化
+  // 都会经过 DidDraw()；WebGL 的绘制缓冲在合成后可能被清空，不走缓存。
+  std::optional<FingerprintEncodedOutputCache::Key> cache_key;
+  if (IsRenderingContext2D()) {
+    cache_key = FingerprintEncodedOutputCache::MakeKey(
+        *this, encoding_mime_type, quality, source_buffer);
+    String cached =
+        FingerprintEncodedOutputCache::GetDataURL(*this, *cache_key);
+    if (!cached.IsNull()) {
+      return cached;
+    }
+  }
+
   scoped_refptr<StaticBitmapImage> image_bitmap = Snapshot(source_buffer);
 
+  // >>>>> [Canvas 指纹防御] ToDataURL >>>>>
+  // 一次回读、零额外整帧拷贝：噪声直接加在回读缓冲区上并由编码器读取。
+  // 高位深画布不加噪声，按原路径编码。
+  SkBitmap noised_pixels;
+  std::unique_ptr<ImageDataBuffer> data_buffer;
   if (image_bitmap) {
-    // >>>>> [Canvas 指纹防御] ToDataURL 真随机版 >>>>>
-    // 1. 转为 CPU 图像
-    scoped_refptr<StaticBitmapImage> unaccelerated =
-        image_bitmap->MakeUnaccelerated();
-
-    if (unaccelerated) {
-      auto paint_image = unaccelerated->PaintImageForCurrentFrame();
-      auto sk_image = paint_image.GetSwSkImage();
-
-      if (sk_image) {
-        SkBitmap bitmap;
-        // 2. 分配内存
-        if (bitmap.tryAllocPixels(sk_image->imageInfo())) {
-          // 3. 读取像素
-          if (sk_image->readPixels(bitmap.pixmap(), 0, 0)) {
-            // 4. 注入噪音
-            int width = bitmap.width();
-            int height = bitmap.height();
-            // 使用真随机数
-            uint64_t random_seed;
-            if (FingerprintConfig::Instance().IsCanvasNoiseEnabled()) {
-              random_seed = static_cast<uint64_t>(
-                  FingerprintConfig::Instance().GetGlobalSeed());
-            } else {
-              random_seed = base::RandUint64();
-            }
-
-            int target_x = width / 2;
-            int target_y = height / 2;
-
-            if (target_x >= 0 && target_x < width && target_y >= 0 &&
-                target_y < height) {
-              uint32_t* pixel_addr = bitmap.getAddr32(target_x, target_y);
-              if (pixel_addr) {
-                // [修复] 混淆逻辑：先用 Knuth hash 混合 seed，再取 RGB 噪声
-                // 原来直接 & 0x00070707 会导致低位相同的不同 seed 产生相同噪声
-                uint32_t hashed_seed =
-                    static_cast<uint32_t>(random_seed) * 2654435761u;
-                uint32_t noise = hashed_seed & 0x00070707;
-                *pixel_addr ^= noise;
-                // 强制修正 Alpha，防止全透明
-                *pixel_addr |= 0x01000001;
-              }
-              // 混淆相邻像素
-              if (target_x + 1 < width) {
-                uint32_t* pixel_next = bitmap.getAddr32(target_x + 1, target_y);
-                if (pixel_next) {
-                  uint32_t hashed2 =
-                      static_cast<uint32_t>(random_seed >> 10) * 2654435761u;
-                  *pixel_next ^= (hashed2 & 0x00030303);
-                }
-              }
-            }
-
-            // 5. 应用修改
-            sk_sp<SkImage> new_image = SkImages::RasterFromBitmap(bitmap);
-            if (new_image) {
-              image_bitmap = UnacceleratedStaticBitmapImage::Create(new_image);
-            }
-          }
-        }
-      }
+    const FingerprintCanvasReadback readback(
+        FingerprintCanvasReadback::Mode::kExport);
+    FINGERPRINT_TRACE_HOOK("ToDataURL", readback.spoofed());
+    if (readback.Readback(*image_bitmap, noised_pixels)) {
+      data_buffer = ImageDataBuffer::Create(noised_pixels.pixmap());
     }
-    // <<<<< [Canvas 指纹防御结束] <<<<<
   }
-
-  std::unique_ptr<ImageDataBuffer> data_buffer =
-      ImageDataBuffer::Create(image_bitmap);
+  if (!data_buffer) {
+    data_buffer = ImageDataBuffer::Create(image_bitmap);
+  }
+  // <<<<< [Canvas 指纹防御结束] <<<<<
 
   if (!data_buffer) {
     return String("data:,");
   }
 
   String data_url = data_buffer->ToDataURL(encoding_mime_type, quality);
+  if (cache_key) {
+    FingerprintEncodedOutputCache::PutDataURL(*this, *cache_key, data_url);
+  }
 
   base::TimeDelta elapsed_time = base::TimeTicks::Now() - start_time;
   float sqrt_pixels =
@@ -1468,6 +1439,23 @@ void HTMLCanvasElement::toBlob(V8BlobCallback* callback,
       ImageEncoderUtils::ToEncodingMimeType(
           mime_type, ImageEncoderUtils::kEncodeReasonToBlobCallback);
 
+  // [Canvas 指纹防御] 内容未变时复用上次的编码结果，见 ToDataURLInternal()
+  std::optional<FingerprintEncodedOutputCache::Key> cache_key;
+  if (IsRenderingContext2D()) {
+    cache_key = FingerprintEncodedOutputCache::MakeKey(
+        *this, encoding_mime_type, quality, /*source_buffer=*/0);
+    if (Blob* cached =
+            FingerprintEncodedOutputCache::GetBlob(*this, *cache_key)) {
+      GetDocument()
+          .GetTaskRunner(TaskType::kCanvasBlobSerialization)
+          ->PostTask(FROM_HERE,
+                     BindOnce(&V8BlobCallback::InvokeAndReportException,
+                              WrapPersistent(callback), nullptr,
+                              WrapPersistent(cached)));
+      return;
+    }
+  }
+
   CanvasAsyncBlobCreator* async_creator = nullptr;
   scoped_refptr<StaticBitmapImage> image_bitmap = Snapshot(kBackBuffer);
   if (image_bitmap) {
@@ -1480,6 +1468,10 @@ void HTMLCanvasElement::toBlob(V8BlobCallback* callback,
   }
 
   if (async_creator) {
+    if (cache_key) {
+      FingerprintEncodedOutputCache::ExpectBlob(*this, *cache_key,
+                                                *async_creator);
+    }
     async_creator->ScheduleAsyncBlobCreation(quality);
   } else {
     GetDocument()
@@ -1937,9 +1929,14 @@ ScriptPromise<ImageBitmap> HTMLCanvasElement::CreateImageBitmap(
         "`createImageBitmap()` cannot be called with open layers.");
     return EmptyPromise();
   }
-  return ImageBitmapSource::FulfillImageBitmap(
-      script_state, MakeGarbageCollected<ImageBitmap>(this, crop_rect, options),
-      options, exception_state);
+  // [Canvas 指纹防御] 与 getImageData 相同的坐标噪声
+  ImageBitmap* image_bitmap =
+      FingerprintCanvasReadback(FingerprintCanvasReadback::Mode::kReadback)
+          .ApplyToImageBitmap(
+              MakeGarbageCollected<ImageBitmap>(this, crop_rect, options),
+              crop_rect);
+  return ImageBitmapSource::FulfillImageBitmap(script_state, image_bitmap,
+                                               options, exception_state);
 }
 
 void HTMLCanvasElement::SetOffscreenCanvasResource(
@@ -13,6 +13,8 @@
 #include "third_party/blink/renderer/bindings/core/v8/v8_canvas_text_baseline.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_text_cluster_options.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/geometry/dom_rect_read_only.h"
 #include "third_party/blink/renderer/core/html/canvas/text_cluster.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
@@ -35,6 +37,8 @@
 namespace blink {
 
 constexpr int kHangingAsPercentOfAscent = 80;
+// measureText() noise: largest change, in px, to the measured width.
+constexpr double kMeasureTextNoiseMax = 0.002;
 
 float TextMetrics::GetFontBaseline(
     const V8CanvasTextBaseline::Enum text_baseline,
@@ -161,36 +165,30 @@ void TextMetrics::Update(const Font* font,
 
   // >>>>> [Canvas 字体指纹防御 - 正式版] >>>>>
   // <<<<< [Canvas 字体指纹防御 - 正式版] <<<<<
+  const bool measure_text_spoofed =
+      FingerprintConfig::Instance().GetCanvasMeasureTextNoiseEnable();
+  FINGERPRINT_TRACE_HOOK(
+      "MeasureText",
+      FingerprintConfig::Instance().IsFontNoiseEnabled() ||
+          measure_text_spoofed);
+  // 两处噪声共用同一个文本计数器，整段文本至多哈希一次。
+  const uint64_t text_counter =
+      FingerprintConfig::Instance().IsFontNoiseEnabled() ||
+              measure_text_spoofed
+          ? FingerprintNoise::CounterFromString(text_)
+          : 0;
   if (FingerprintConfig::Instance().IsFontNoiseEnabled()) {
     int prob = FingerprintConfig::Instance().GetFontsOffsetNoiseProbPercent();
-    int seed = FingerprintConfig::Instance().GetGlobalSeed();
 
     // [修复] 使用稳定的内容 Hash，不依赖 WTF 的每进程随机 Hash 种子
-    // WTF::StringImpl::GetHash() 在每次浏览器启动时会使用不同的随机种子，
-    // 导致同一文本在不同启动中产生不同的 hash，破坏确定性。
-    // 这里使用简单的多项式 hash (seed * 31 + char) 来确保稳定性。
-    unsigned stable_hash = 0;
-    if (text_.length() > 0) {
-      for (unsigned i = 0; i < text_.length(); i++) {
-        stable_hash = stable_hash * 31u + text_[i];
-      }
-    }
-
-    // [修复] 将 global_seed 直接 XOR 进 hash 中
-    // 这样改变 seed 就会直接改变 hash 值，而不是像 sin(大数+小数) 那样被淹没
-    unsigned combined = stable_hash ^ static_cast<unsigned>(seed);
+    // (WTF::StringImpl::GetHash() 每次启动种子不同，会破坏确定性)。
+    // seed 作为 PRNG 的 key 参与，不会像 sin(大数+小数) 那样被淹没。
+    const FingerprintNoise noise(FingerprintNoiseDomain::kCanvasText);
 
-    // 1. 概率检查 (使用 combined hash 取模，完全确定性)
-    int prob_value = static_cast<int>(combined % 100u);
-    if (prob_value < prob) {
-      // 2. 噪声因子: 最大偏离 2px (Font Box
-      // 显示整数值，需要足够大才能跨整数边界)
-      double noise_factor = 2.0;
-
-      // 3. 生成确定性噪声 (使用小范围输入避免浮点精度问题)
-      double noise_input = static_cast<double>(combined % 100000u);
-      double final_noise =
-          FingerprintConfig::GenerateNoise(noise_input, noise_factor);
+    // 1. 概率检查 (偶数计数器)；2. 噪声 (奇数计数器)，最大偏离 2px
+    // (Font Box 显示整数值，需要足够大才能跨整数边界)
+    if (noise.Chance(text_counter * 2, prob)) {
+      double final_noise = noise.Signed(text_counter * 2 + 1) * 2.0;
 
       // 4. 应用噪声
       width_ += final_noise;
@@ -212,6 +210,20 @@ void TextMetrics::Update(const Font* font,
       }
     }
   }
+
+  // [Canvas 指纹防御] measureText 噪声：整形之后按 (seed, 字体, 文本) 确定性地
+  // 微调宽度。被测文本保持原样，重复测量同一字符串会命中整形缓存，结果也
+  // 每次相同。
+  if (measure_text_spoofed && !text_.empty()) {
+    const FingerprintNoise noise(FingerprintNoiseDomain::kMeasureText);
+    const uint64_t counter =
+        noise.Bits(FingerprintNoise::CounterFromFont(
+            font_->GetFontDescription())) ^
+        text_counter;
+    const double width_noise = noise.Signed(counter) * kMeasureTextNoiseMax;
+    width_ += width_noise;
+    actual_bounding_box_right_ += width_noise;
+  }
   // >>>>> [Canvas 字体指纹防御] >>>>>
 }
 
@@ -82,6 +82,8 @@
 #include "third_party/blink/renderer/core/events/toggle_event.h"
 #include "third_party/blink/renderer/core/frame/csp/content_security_policy.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/frame/settings.h"
@@ -145,23 +147,15 @@
 // 参数 measurement: 元素的原始测量值 (offsetWidth/offsetHeight)
 // 返回值: 基于 global_seed 和 measurement 的确定性噪声 (-1, 0, 或 +1)
 int getDeterministicFontNoise(int measurement) {
-  // 读取配置
   int prob =
       blink::FingerprintConfig::Instance().GetFontsOffsetNoiseProbPercent();
-  int seed = blink::FingerprintConfig::Instance().GetGlobalSeed();
-
-  // 将 seed 和 measurement 混合 (Knuth 乘法散列)
+  FINGERPRINT_TRACE_HOOK("OffsetFontNoise", prob > 0);
   // measurement 是内容相关的 (不同元素、不同字体 → 不同测量值)
-  // seed 确保改变种子后噪声完全不同
-  unsigned combined =
-      (static_cast<unsigned>(measurement) ^ static_cast<unsigned>(seed)) *
-      2654435761u;
-
-  // 概率检查: 使用 combined 的高位做概率判断
-  int prob_value = static_cast<int>((combined >> 8) % 100u);
-  if (prob_value < prob) {
-    // 噪声值: 根据 combined 的最低位决定 +1 或 -1
-    return (combined & 1u) ? 1 : -1;
+  // 偶数计数器做概率判断，奇数计数器决定 +1 或 -1，两者互不相关
+  const blink::FingerprintNoise noise(blink::FingerprintNoiseDomain::kFonts);
+  const uint64_t counter = static_cast<uint32_t>(measurement);
+  if (noise.Chance(counter * 2, prob)) {
+    return (noise.Bits(counter * 2 + 1) & 1u) ? 1 : -1;
   }
   return 0;
 }
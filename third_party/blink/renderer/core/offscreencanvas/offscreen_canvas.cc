@@ -5,6 +5,7 @@
 #include "third_party/blink/renderer/core/offscreencanvas/offscreen_canvas.h"
 
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "base/metrics/histogram_functions.h"
@@ -12,12 +13,15 @@
 #include "base/task/single_thread_task_runner.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/public/platform/scheduler/web_agent_group_scheduler.h"
+#include "third_party/blink/renderer/bindings/core/v8/script_promise.h"
 #include "third_party/blink/renderer/core/css/css_font_selector.h"
 #include "third_party/blink/renderer/core/css/offscreen_font_selector.h"
 #include "third_party/blink/renderer/core/css/style_engine.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 #include "third_party/blink/renderer/core/fileapi/blob.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_canvas_readback.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_encoded_output_cache.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/html/canvas/canvas_async_blob_creator.h"
@@ -150,6 +154,7 @@ void OffscreenCanvas::setHeight(unsigned height) {
 }
 
 void OffscreenCanvas::SetSize(gfx::Size size) {
+  FingerprintEncodedOutputCache::Invalidate(*this);
   // Setting size of a canvas also resets it.
   if (size == Size()) {
     if (context_ && context_->IsRenderingContext2D()) {
@@ -279,12 +284,17 @@ ScriptPromise<ImageBitmap> OffscreenCanvas::CreateImageBitmap(
   if (context_) {
     context_->FinalizeFrame(FlushReason::kOther);
   }
-  return ImageBitmapSource::FulfillImageBitmap(
-      script_state,
+  // Same coordinate-keyed noise as getImageData(), applied on the thread
+  // that owns this canvas.
+  ImageBitmap* image_bitmap =
       IsPaintable()
-          ? MakeGarbageCollected<ImageBitmap>(this, crop_rect, options)
-          : nullptr,
-      options, exception_state);
+          ? FingerprintCanvasReadback(FingerprintCanvasReadback::Mode::kReadback)
+                .ApplyToImageBitmap(
+                    MakeGarbageCollected<ImageBitmap>(this, crop_rect, options),
+                    crop_rect)
+          : nullptr;
+  return ImageBitmapSource::FulfillImageBitmap(script_state, image_bitmap,
+                                               options, exception_state);
 }
 
 ScriptPromise<Blob> OffscreenCanvas::convertToBlob(
@@ -335,6 +345,22 @@ ScriptPromise<Blob> OffscreenCanvas::convertToBlob(
     return EmptyPromise();
   }
 
+  // Unchanged 2D content is not encoded again; see
+  // FingerprintEncodedOutputCache.
+  std::optional<FingerprintEncodedOutputCache::Key> cache_key;
+  if (context_->IsRenderingContext2D()) {
+    cache_key = FingerprintEncodedOutputCache::MakeKey(
+        *this,
+        ImageEncoderUtils::ToEncodingMimeType(
+            options->type(),
+            ImageEncoderUtils::kEncodeReasonConvertToBlobPromise),
+        options->quality(), /*source_buffer=*/0);
+    if (Blob* cached =
+            FingerprintEncodedOutputCache::GetBlob(*this, *cache_key)) {
+      return ToResolvedPromise<Blob>(script_state, cached);
+    }
+  }
+
   base::TimeTicks start_time = base::TimeTicks::Now();
   scoped_refptr<StaticBitmapImage> image_bitmap = context_->GetImage();
   if (image_bitmap) {
@@ -346,6 +372,10 @@ ScriptPromise<Blob> OffscreenCanvas::convertToBlob(
     auto* async_creator = MakeGarbageCollected<CanvasAsyncBlobCreator>(
         image_bitmap, options, function_type, start_time, execution_context,
         resolver);
+    if (cache_key) {
+      FingerprintEncodedOutputCache::ExpectBlob(*this, *cache_key,
+                                                *async_creator);
+    }
     async_creator->ScheduleAsyncBlobCreation(options->quality());
     return resolver->Promise();
   }
@@ -486,6 +516,7 @@ void OffscreenCanvas::DidDraw(const SkIRect& rect) {
   if (rect.isEmpty()) {
     return;
   }
+  FingerprintEncodedOutputCache::Invalidate(*this);
 
   if (HasPlaceholderCanvas()) {
     needs_push_frame_ = true;
@@ -12,7 +12,7 @@
 #include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/renderer/core/dom/events/event.h"
-#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_timezone.h"
 #include "third_party/blink/renderer/core/frame/frame.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
@@ -96,7 +96,8 @@ void NotifyTimezoneChangeOnMainThread() {
 TimeZoneController::TimeZoneController() {
   DCHECK(IsMainThread());
   if (!base::FeatureList::IsEnabled(kLazyBlinkTimezoneInit)) {
-    host_timezone_id_ = GetCurrentTimezoneId();
+    host_timezone_id_ =
+        FingerprintTimezone::ResolveHostZoneId(GetCurrentTimezoneId());
   }
 }
 
@@ -111,13 +112,10 @@ void TimeZoneController::Init() {
   Platform::Current()->GetBrowserInterfaceBroker()->GetInterface(
       monitor.BindNewPipeAndPassReceiver());
   monitor->AddClient(instance().receiver_.BindNewPipeAndPassRemote());
-
-  // [Added] Fingerprint Spoofing - Initialize Timezone Override
-  const auto* config = FingerprintConfig::GetInstance();
-  if (config && config->timezone.spoofing_enabled &&
-      !config->timezone.zone_id.empty()) {
-    SetTimeZoneOverride(config->timezone.zone_id);
-  }
+  // [Added] Fingerprint Spoofing: the identity's zone is applied process-wide
+  // by FingerprintTimezone and reported here as the host zone (see
+  // FingerprintTimezone::ResolveHostZoneId()), so it is not an override and
+  // DevTools emulation keeps working on top of it.
 }
 
 // static
@@ -226,11 +224,9 @@ void TimeZoneController::ChangeTimeZoneOverride(const String& timezone_id) {
 
 bool TimeZoneController::SetIcuTimeZoneAndNotifyV8(const String& timezone_id) {
   DCHECK(!timezone_id.empty());
-  std::unique_ptr<icu::TimeZone> timezone(icu::TimeZone::createTimeZone(
-      icu::UnicodeString(timezone_id.Ascii().data(), -1, US_INV)));
-  CHECK(timezone);
-
-  if (*timezone == icu::TimeZone::getUnknown()) {
+  std::unique_ptr<icu::TimeZone> timezone =
+      FingerprintTimezone::CreateIcuTimeZone(timezone_id.Ascii());
+  if (!timezone) {
     return false;
   }
 
@@ -254,12 +250,20 @@ void TimeZoneController::OnTimeZoneChange(const String& timezone_id) {
 
   base::AutoLock locker(instance().lock_);
 
+  // [Added] Fingerprint Spoofing: the real OS zone never reaches ICU while
+  // the identity spoofs the timezone.
+  const String resolved_timezone_id =
+      FingerprintTimezone::ResolveHostZoneId(timezone_id);
+  if (resolved_timezone_id == instance().host_timezone_id_) {
+    return;
+  }
+
   // Remember requested timezone id so we can set it when timezone
   // override is removed.
-  instance().host_timezone_id_ = timezone_id;
+  instance().host_timezone_id_ = resolved_timezone_id;
 
   if (!HasTimeZoneOverride()) {
-    SetIcuTimeZoneAndNotifyV8(timezone_id);
+    SetIcuTimeZoneAndNotifyV8(resolved_timezone_id);
   }
 }
 
@@ -267,7 +271,8 @@ const String& TimeZoneController::GetHostTimezoneId() {
   lock_.AssertAcquired();
   if (host_timezone_id_.IsNull()) {
     CHECK(base::FeatureList::IsEnabled(kLazyBlinkTimezoneInit));
-    host_timezone_id_ = GetCurrentTimezoneId();
+    host_timezone_id_ =
+        FingerprintTimezone::ResolveHostZoneId(GetCurrentTimezoneId());
   }
   return host_timezone_id_;
 }
@@ -44,7 +44,7 @@ WorkerNavigator::~WorkerNavigator() = default;
 // [뿪ʼ] ￪ʼָƻ߼
 
 String WorkerNavigator::userAgent() const {
-  FingerprintConfig* config = FingerprintConfig::GetInstance();
+  const FingerprintConfig* config = FingerprintConfig::GetInstance();
   if (config && config->ua.enabled) {
     return config->ua.ua_string;
   }
@@ -52,7 +52,7 @@ String WorkerNavigator::userAgent() const {
 }
 
 String WorkerNavigator::platform() const {
-  FingerprintConfig* config = FingerprintConfig::GetInstance();
+  const FingerprintConfig* config = FingerprintConfig::GetInstance();
   if (config && config->ua.enabled) {
     return config->ua.platform;
   }
@@ -61,7 +61,7 @@ String WorkerNavigator::platform() const {
 
 //  1: ֵ͸Ϊ unsigned
 unsigned WorkerNavigator::hardwareConcurrency() const {
-  FingerprintConfig* config = FingerprintConfig::GetInstance();
+  const FingerprintConfig* config = FingerprintConfig::GetInstance();
   if (config) {
     // ǿתΪ unsigned ƥǩ
     return static_cast<unsigned>(config->GetHardwareConcurrency());
@@ -71,7 +71,7 @@ unsigned WorkerNavigator::hardwareConcurrency() const {
 
 //  2:  floatʵָ߼
 float WorkerNavigator::deviceMemory() const {
-  FingerprintConfig* config = FingerprintConfig::GetInstance();
+  const FingerprintConfig* config = FingerprintConfig::GetInstance();
   if (config) {
     return config->GetDeviceMemory();
   }
@@ -11,7 +11,6 @@
 #include <cstdlib>
 #include <memory>
 #include <optional>
-#include <random>
 #include <utility>
 
 #include "base/check.h"
@@ -23,7 +22,6 @@
 #include "base/notreached.h"
 #include "base/numerics/checked_math.h"
 #include "base/numerics/safe_conversions.h"
-#include "base/process/process_handle.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/time/time.h"
 #include "cc/paint/paint_canvas.h"
@@ -48,7 +46,11 @@
 #include "third_party/blink/renderer/core/dom/events/event.h"
 #include "third_party/blink/renderer/core/dom/node.h"
 #include "third_party/blink/renderer/core/event_type_names.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_canvas_readback.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_image_data_pool.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/frame/web_feature.h"
 #include "third_party/blink/renderer/core/html/canvas/canvas_font_cache.h"
 #include "third_party/blink/renderer/core/html/canvas/canvas_performance_monitor.h"
@@ -102,23 +104,7 @@
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "ui/gfx/geometry/skia_conversions.h"
-
-double getSubPixelNoise(int max_factor) {
-  if (max_factor <= 0) {
-    return 0.0;
-  }
-  //                   +      ID                 5
-  static std::mt19937 generator([]() {
-    uint32_t seed = static_cast<uint32_t>(
-        base::TimeTicks::Now().since_origin().InMicroseconds());
-    seed ^= (static_cast<uint32_t>(base::GetCurrentProcId()) << 16);
-    return seed;
-  }());
-  //      -max*10    +max*10                  10000
-  std::uniform_int_distribution<int> distribution(-max_factor * 10,
-                                                  max_factor * 10);
-  return static_cast<double>(distribution(generator)) / 10000.0;
-}
+#include "ui/gfx/geometry/vector2d_f.h"
 
 // Including "base/time/time.h" triggers a bug in IWYU.
 // https://github.com/include-what-you-use/include-what-you-use/issues/1122
@@ -150,6 +136,37 @@ bool IsContextProviderValid() {
          !context_provider_wrapper->ContextProvider().IsContextLost();
 }
 
+// [Canvas 指纹防御] fillText / strokeText 及其 cluster 版本共用的文字位置抖动。
+// 抖动是 (seed, 字体, 文本, 绘制区间) 的纯函数：同一段文字每帧都落在同一
+// 位置，录制出的 PaintRecord 逐帧相同，录制与光栅缓存都能复用。文本只以
+// CounterFromString() 的 64 位内容计数器参与，长字符串的计数器已按线程缓存，
+// 重复绘制同一字符串时不再对全文求哈希，这里也不再保留文本本身。
+// Offset, at most canvas_fill_text_offset / 1000 px per axis, for drawing
+// |text|[run_start, run_end) in |font|.
+gfx::Vector2dF TextJitter(const Font& font,
+                          const String& text,
+                          unsigned run_start,
+                          unsigned run_end) {
+  const FingerprintConfig& config = FingerprintConfig::Instance();
+  const int max_offset = config.GetCanvasFillTextOffsetMax();
+  FINGERPRINT_TRACE_HOOK("TextDrawJitter", max_offset > 0);
+  if (max_offset <= 0) {
+    return gfx::Vector2dF();
+  }
+  const FingerprintNoise noise(config.GetGlobalSeed(),
+                               FingerprintNoiseDomain::kTextDraw);
+  uint64_t text_key =
+      noise.Bits(FingerprintNoise::CounterFromFont(font.GetFontDescription()));
+  if (!text.IsNull()) {
+    text_key ^= FingerprintNoise::CounterFromString(text);
+  }
+  const uint64_t counter =
+      2 * (text_key ^ ((static_cast<uint64_t>(run_start) << 32) | run_end));
+  const double scale = max_offset / 1000.0;
+  return gfx::Vector2dF(noise.Signed(counter) * scale,
+                        noise.Signed(counter + 1) * scale);
+}
+
 }  // namespace
 
 constexpr char kDefaultFont[] = "10px sans-serif";
@@ -523,27 +540,44 @@ ImageData* BaseRenderingContext2D::getImageDataInternal(
     validate_and_create_params.zero_initialize = true;
   }
 
-  image_data =
-      ImageData::ValidateAndCreate(sw, sh, std::nullopt, image_data_settings,
-                                   validate_and_create_params, exception_state);
-  if (!image_data) {
-    return nullptr;
+  // willReadFrequently 画布通常每帧都读：复用页面已丢弃的 ImageData 缓冲区，
+  // 像素照常直接读入其中并原地加噪。
+  const bool pool_image_data =
+      will_read_frequently_value ==
+          CanvasContextCreationAttributesCore::WillReadFrequently::kTrue &&
+      !image_data_settings;
+  if (pool_image_data) {
+    image_data = FingerprintImageDataPool::Take(
+        *GetCanvasRenderingContextHost(), gfx::Size(sw, sh),
+        validate_and_create_params, exception_state);
+    if (exception_state.HadException()) {
+      return nullptr;
+    }
   }
-
-  auto ApplyCanvasReadbackNoise = [](ImageData* data) {
-    if (!data) {
-      return;
+  if (!image_data) {
+    image_data = ImageData::ValidateAndCreate(
+        sw, sh, std::nullopt, image_data_settings, validate_and_create_params,
+        exception_state);
+    if (!image_data) {
+      return nullptr;
     }
-    if (!blink::FingerprintConfig::Instance()
-             .GetCanvasMeasureTextNoiseEnable()) {
-      return;
+    if (pool_image_data) {
+      FingerprintImageDataPool::Track(
+          *GetCanvasRenderingContextHost(), *image_data,
+          validate_and_create_params.default_color_space);
     }
-    SkPixmap pixmap = data->GetSkPixmap();
-    uint8_t* pixels = static_cast<uint8_t*>(pixmap.writable_addr());
-    if (pixels && pixmap.computeByteSize() > 4) {
-      const uint64_t micro =
-          base::TimeTicks::Now().since_origin().InMicroseconds();
-      pixels[0] ^= static_cast<uint8_t>(micro & 1);
+  }
+
+  // [Canvas 指纹防御] 对整块返回区域施加按画布坐标确定的低位噪声。
+  // HTMLCanvas 与 OffscreenCanvas 都经过这里，同一像素无论以何种区域、
+  // 何种路径读取，得到的噪声都相同。
+  auto ApplyCanvasReadbackNoise = [sx, sy](ImageData* data) {
+    const FingerprintCanvasReadback readback(
+        FingerprintCanvasReadback::Mode::kReadback);
+    FINGERPRINT_TRACE_HOOK("GetImageData", readback.spoofed());
+    if (data) {
+      // Float16/Float32 ImageData 不加噪声。
+      readback.ApplyToPixmap(data->GetSkPixmap(), sx, sy);
     }
   };
 
@@ -928,35 +962,16 @@ void BaseRenderingContext2D::setDirection(const V8CanvasDirection direction) {
 }
 
 void BaseRenderingContext2D::fillText(const String& text, double x, double y) {
-  // >>>>>>>>>
-  int max_offset =
-      blink::FingerprintConfig::Instance().GetCanvasFillTextOffsetMax();
-  x += getSubPixelNoise(max_offset);
-  y += getSubPixelNoise(max_offset);
-  // <<<<<<<<<
-
-  //          DrawTextInternal         (align, baseline, start, end)
   const CanvasRenderingContext2DState& state = GetState();
   DrawTextInternal(text, x, y, CanvasRenderingContext2DState::kFillPaintType,
-                   state.GetTextAlign(),     //         5
-                   state.GetTextBaseline(),  //         6
-                   0,                        //         7 (run_start)
-                   text.length());           //         8 (run_end)
+                   state.GetTextAlign(), state.GetTextBaseline(), 0,
+                   text.length());
 }
 
-//      2:    max_width
 void BaseRenderingContext2D::fillText(const String& text,
                                       double x,
                                       double y,
                                       double max_width) {
-  // >>>>>>>>>
-  int max_offset =
-      blink::FingerprintConfig::Instance().GetCanvasFillTextOffsetMax();
-  x += getSubPixelNoise(max_offset);
-  y += getSubPixelNoise(max_offset);
-  // <<<<<<<<<
-
-  //          DrawTextInternal
   const CanvasRenderingContext2DState& state = GetState();
   DrawTextInternal(text, x, y, CanvasRenderingContext2DState::kFillPaintType,
                    state.GetTextAlign(), state.GetTextBaseline(), 0,
@@ -1119,7 +1134,9 @@ void BaseRenderingContext2D::DrawTextInternal(
   PlainTextPainter& text_painter = host->GetPlainTextPainter();
   TextRun text_run(text, direction, bidi_override);
   // Draw the item text at the correct point.
-  gfx::PointF location(ClampTo<float>(x), ClampTo<float>(y));
+  const gfx::Vector2dF jitter = TextJitter(*font, text, run_start, run_end);
+  gfx::PointF location(ClampTo<float>(x + jitter.x()),
+                       ClampTo<float>(y + jitter.y()));
   gfx::RectF bounds;
   double font_width = 0;
   if (run_start == 0 && run_end == text.length()) [[likely]] {
@@ -1231,17 +1248,11 @@ TextMetrics* BaseRenderingContext2D::measureText(const String& text) {
   TextDirection direction =
       ToTextDirection(state.GetDirection(), host, computed_style);
 
-  String modified_text = text;
-  if (blink::FingerprintConfig::Instance().GetCanvasMeasureTextNoiseEnable()) {
-    //                      0
-    if (getSubPixelNoise(2) != 0 && text.length() > 0) {
-      modified_text = text + " ";
-    }
-  }
-
+  // measureText noise is applied to the shaped metrics in TextMetrics, so the
+  // text measured is the text the page passed and its shaping is cached.
   return MakeGarbageCollected<TextMetrics>(
-      font, direction, state.GetTextBaseline(), state.GetTextAlign(),
-      modified_text, host->GetPlainTextPainter());
+      font, direction, state.GetTextBaseline(), state.GetTextAlign(), text,
+      host->GetPlainTextPainter());
 }
 
 String BaseRenderingContext2D::lang() const {
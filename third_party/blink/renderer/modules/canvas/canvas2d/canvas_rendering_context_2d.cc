@@ -75,7 +75,6 @@
 #include "third_party/blink/renderer/core/css/style_engine.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/element.h"
-#include "third_party/blink/renderer/core/frame/fingerprint_config.h"
 #include "third_party/blink/renderer/core/frame/settings.h"
 #include "third_party/blink/renderer/core/frame/web_feature.h"
 #include "third_party/blink/renderer/core/geometry/dom_matrix.h"
@@ -781,93 +780,10 @@ ImageData* CanvasRenderingContext2D::getImageDataInternal(
           CanvasContextCreationAttributesCore::WillReadFrequently::kTrue);
   TRACE_EVENT0("blink", "GetImageData");
 
-  // 1. 获取原始数据
-  ImageData* image_data = BaseRenderingContext2D::getImageDataInternal(
+  // [Canvas 指纹防御] 像素噪声统一在 BaseRenderingContext2D 中施加，
+  // HTMLCanvas 与 OffscreenCanvas 两条路径得到相同的结果
+  return BaseRenderingContext2D::getImageDataInternal(
       sx, sy, sw, sh, image_data_settings, exception_state);
-
-  // >>>>> [Canvas 指纹防御] 开始 >>>>>
-  // 使用 FingerprintConfig 读取配置开关
-  // 复用 MeasureText 的开关，或者在 Config 中添加专门控制 PixelNoise 的开关
-  if (image_data &&
-      blink::FingerprintConfig::Instance().GetCanvasMeasureTextNoiseEnable()) {
-    const auto* data_union = image_data->data();
-
-    // 检查是否为 Uint8ClampedArray (标准 Canvas 像素格式)
-    if (data_union && data_union->IsUint8ClampedArray()) {
-      auto data_array = data_union->GetAsUint8ClampedArray();
-
-      // 获取数据指针
-      unsigned char* pixels = const_cast<unsigned char*>(data_array->Data());
-      size_t length = data_array->length();
-
-      // 确保有足够的数据修改 (至少 200 字节)
-      if (length >= 200) {
-        // 使用确定性噪声生成器 (基于 FingerprintConfig)
-        // 注意：GenerateNoise 返回 double，我们需要将其转换为字节噪声
-
-        size_t center_idx = (length / 2);
-        center_idx = (center_idx / 4) * 4;  // 对齐像素
-
-        // 使用 UNSAFE_BUFFERS 跳过编译器安全检查
-        UNSAFE_BUFFERS({
-          // [修复] 将 seed 混入索引，确保 seed 变化直接改变噪声
-          int seed = blink::FingerprintConfig::Instance().GetGlobalSeed();
-          unsigned seed_mix = static_cast<unsigned>(seed);
-
-          // --- 混淆点 1: 中心像素 ---
-          if (center_idx + 3 < length) {
-            // 使用 XOR + 取模 将输入限制在小范围，避免浮点精度丢失
-            unsigned input0 =
-                (static_cast<unsigned>(center_idx) ^ seed_mix) % 100000u;
-            double noise_val = blink::FingerprintConfig::GenerateNoise(
-                static_cast<double>(input0), 7.0);
-            uint8_t noise_byte =
-                static_cast<uint8_t>(std::abs(noise_val)) & 0x07;
-
-            pixels[center_idx + 0] ^= noise_byte;  // R
-
-            unsigned input1 =
-                (static_cast<unsigned>(center_idx + 1) ^ seed_mix) % 100000u;
-            noise_val = blink::FingerprintConfig::GenerateNoise(
-                static_cast<double>(input1), 7.0);
-            pixels[center_idx + 1] ^=
-                (static_cast<uint8_t>(std::abs(noise_val)) & 0x07);  // G
-
-            unsigned input2 =
-                (static_cast<unsigned>(center_idx + 2) ^ seed_mix) % 100000u;
-            noise_val = blink::FingerprintConfig::GenerateNoise(
-                static_cast<double>(input2), 7.0);
-            pixels[center_idx + 2] ^=
-                (static_cast<uint8_t>(std::abs(noise_val)) & 0x07);  // B
-
-            // 强制 Alpha 不为 0
-            if (pixels[center_idx + 3] == 0) {
-              pixels[center_idx + 3] = 1;
-            }
-          }
-
-          // --- 混淆点 2: 偏移 64 像素 ---
-          size_t offset_idx = center_idx + 64;
-          if (offset_idx + 3 < length) {
-            unsigned input_off =
-                (static_cast<unsigned>(offset_idx + 2) ^ seed_mix) % 100000u;
-            double noise_val = blink::FingerprintConfig::GenerateNoise(
-                static_cast<double>(input_off), 3.0);
-
-            pixels[offset_idx + 2] ^=
-                (static_cast<uint8_t>(std::abs(noise_val)) & 0x03);  // B 微调
-
-            if (pixels[offset_idx + 3] == 0) {
-              pixels[offset_idx + 3] = 1;
-            }
-          }
-        });
-      }
-    }
-  }
-  // <<<<< [Canvas 指纹防御] 结束 <<<<<
-
-  return image_data;
 }
 
 DOMMatrix* CanvasRenderingContext2D::drawElement(
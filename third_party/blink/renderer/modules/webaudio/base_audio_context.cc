@@ -40,6 +40,8 @@
 #include "third_party/blink/renderer/bindings/modules/v8/v8_periodic_wave_constraints.h"
 #include "third_party/blink/renderer/core/dom/dom_exception.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/settings.h"
 #include "third_party/blink/renderer/core/html/media/html_media_element.h"
@@ -1053,6 +1055,8 @@ float BaseAudioContext::sampleRate() const {
   float rate = destination_handler_->SampleRate();
   // [Modified] Fingerprint Spoofing
   const auto* config = FingerprintConfig::GetInstance();
+  FINGERPRINT_TRACE_HOOK("AudioSampleRate",
+                         config && config->audio.spoofing_enabled);
   if (config && config->audio.spoofing_enabled) {
     double noise = 0.0;
     if (config->audio.sample_rate_offset != 0.0) {
@@ -1063,7 +1067,9 @@ float BaseAudioContext::sampleRate() const {
       if (max_offset <= 0) {
         max_offset = 100.0;
       }
-      noise = FingerprintConfig::GenerateNoise(rate, max_offset);
+      noise = FingerprintNoise(FingerprintNoiseDomain::kAudio)
+                  .Signed(FingerprintNoise::CounterFromDouble(rate)) *
+              max_offset;
     }
     return rate + static_cast<float>(noise);
   }
@@ -37,6 +37,8 @@
 
 // [Added] Fingerprint Spoofing
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 
 namespace blink {
 
@@ -176,6 +178,8 @@ float DynamicsCompressorNode::reduction() const {
   float reduction_val = GetDynamicsCompressorHandler().ReductionValue();
   // [Modified] Fingerprint Spoofing
   const auto* config = FingerprintConfig::GetInstance();
+  FINGERPRINT_TRACE_HOOK("CompressorReduction",
+                         config && config->audio.spoofing_enabled);
   if (config && config->audio.spoofing_enabled) {
     // Add small deterministic noise.
     // reduction is usually < 0 (dB).
@@ -190,9 +194,12 @@ float DynamicsCompressorNode::reduction() const {
     // If reduction changes over time (it does), adding noise might make it
     // jittery if not careful. But reduction IS jittery (it follows the signal).
     // Adding distinct noise makes it harder to fingerprint the exact compressor
-    // behavior? Or just adds noise to the readout. Let's use GenerateNoise with
-    // reduction_val as input for consistency.
-    double noise = FingerprintConfig::GenerateNoise(reduction_val, factor);
+    // behavior? Or just adds noise to the readout. Key the audio noise stream
+    // with reduction_val for consistency.
+    double noise =
+        FingerprintNoise(FingerprintNoiseDomain::kAudio)
+            .Signed(FingerprintNoise::CounterFromDouble(reduction_val)) *
+        factor;
     return reduction_val + static_cast<float>(noise);
   }
   return reduction_val;
@@ -26,6 +26,7 @@
 #include <time.h>
 #include "third_party/blink/renderer/modules/webaudio/offline_audio_context.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "media/base/audio_glitch_info.h"
@@ -268,6 +269,9 @@ ScriptPromise<AudioBuffer> OfflineAudioContext::startOfflineRendering(
   static_cast<OfflineAudioDestinationNode*>(destination())
       ->SetDestinationBuffer(render_target);
   DestinationHandler().InitializeOfflineRenderThread(render_target);
+  FINGERPRINT_TRACE_HOOK_BEGIN(
+      "OfflineAudioRender", this,
+      FingerprintConfig::Instance().GetAudioSampleRateOffsetMax() > 0);
   DestinationHandler().StartRendering();
 
   return complete_resolver_->Promise();
@@ -412,6 +416,7 @@ ScriptPromise<IDLUndefined> OfflineAudioContext::resumeContext(
 
 void OfflineAudioContext::FireCompletionEvent() {
   DCHECK(IsMainThread());
+  FINGERPRINT_TRACE_HOOK_END("OfflineAudioRender", this);
 
   // Context is finished, so remove any tail processing nodes; there's nowhere
   // for the output to go.
@@ -25,11 +25,16 @@
 
 #include "third_party/blink/renderer/modules/webgl/webgl_rendering_context_base.h"
 
+#include <string.h>
 #include <time.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <random>
 #include <utility>
 
@@ -66,6 +71,9 @@
 #include "third_party/blink/renderer/bindings/modules/v8/webgl_any.h"
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise_tile.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/frame/local_frame_client.h"
@@ -157,6 +165,7 @@
 #include "third_party/blink/renderer/platform/wtf/text/string_utf8_adaptor.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/geometry/size.h"
 
 // Populates parameters from texImage2D except for border, width, height, and
@@ -1264,6 +1273,8 @@ WebGLRenderingContextBase::WebGLRenderingContextBase(
   DCHECK(context_provider);
 
   xr_compatible_ = requested_attributes.xr_compatible;
+  fingerprint_render_exact_ =
+      FingerprintConfig::Instance().GetWebGLRenderExact();
 
   max_viewport_dims_ = {};
   context_provider->ContextGL()->GetIntegerv(GL_MAX_VIEWPORT_DIMS,
@@ -2819,14 +2830,36 @@ void WebGLRenderingContextBase::clearColor(GLclampf red,
   if (isContextLost()) {
     return;
   }
-  // >>>>>>>>> 修改 C：背景色随机微调 (增强版)
-  float noise_factor =
-      blink::FingerprintConfig::Instance().GetWebGLClearColorNoise();
-  float noise = static_cast<float>(GetDeterministicNoiseInt(30000) % 10 + 1) *
-                noise_factor;
-
-  ContextGL()->ClearColor(red + noise, green + noise, blue + noise, alpha);
-  // <<<<<<<<< 修改 C 结束
+  // render_exact：原样下发，噪声只在读回出口施加。
+  if (!fingerprint_render_exact_) {
+    // >>>>>>>>> 修改 C：背景色随机微调 (增强版)
+    float noise_factor =
+        blink::FingerprintConfig::Instance().GetWebGLClearColorNoise();
+    FINGERPRINT_TRACE_HOOK("WebGLClearColor", noise_factor != 0);
+    float noise =
+        static_cast<float>(GetDeterministicNoiseInt(30000) % 10 + 1) *
+        noise_factor;
+    red += noise;
+    green += noise;
+    blue += noise;
+    // <<<<<<<<< 修改 C 结束
+  }
+  if (std::isnan(red)) {
+    red = 0;
+  }
+  if (std::isnan(green)) {
+    green = 0;
+  }
+  if (std::isnan(blue)) {
+    blue = 0;
+  }
+  if (std::isnan(alpha)) {
+    alpha = 1;
+  }
+  // Tracked so that ClearIfComposited() and the drawing buffer put back the
+  // page's clear color rather than zero.
+  clear_color_ = {red, green, blue, alpha};
+  ContextGL()->ClearColor(red, green, blue, alpha);
 }
 
 void WebGLRenderingContextBase::clearDepth(GLfloat depth) {
@@ -3733,6 +3766,11 @@ WebGLContextAttributes* WebGLRenderingContextBase::getContextAttributes()
     result->setStencil(false);
   }
   result->setAntialias(GetDrawingBuffer()->Multisample());
+  // [WebGL 指纹防御] GPU profile 指定的 antialias
+  if (std::optional<bool> antialias =
+          FingerprintConfig::Instance().GetWebGLAntialias()) {
+    result->setAntialias(*antialias);
+  }
   result->setXrCompatible(xr_compatible_);
   result->setDesynchronized(Host()->LowLatencyEnabled());
   return result;
@@ -3782,6 +3820,14 @@ bool WebGLRenderingContextBase::ExtensionSupportedAndAllowed(
   if (disabled_extensions_.Contains(String(tracker->ExtensionName()))) {
     return false;
   }
+  // [WebGL 指纹防御] GPU profile 给出扩展列表时，只暴露列表内的扩展，
+  // getExtension() 与 getSupportedExtensions() 保持一致。
+  if (const Vector<String>* profile_extensions =
+          FingerprintConfig::Instance().GetWebGLExtensions();
+      profile_extensions &&
+      !profile_extensions->Contains(String(tracker->ExtensionName()))) {
+    return false;
+  }
   return true;
 }
 
@@ -3938,6 +3984,9 @@ ScriptValue WebGLRenderingContextBase::getParameter(ScriptState* script_state,
 #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
 
   auto& config = blink::FingerprintConfig::Instance();  // 获取配置实例
+  FINGERPRINT_TRACE_HOOK("WebGLGetParameter",
+                         pname == 37445 || pname == 37446 || pname == 7936 ||
+                             pname == 7937 || config.GetWebGLParameter(pname));
 
   if (pname == 37446 || pname == 7937) {
     return WebGLAny(script_state, config.GetWebGLRenderer());  // 读取 Renderer
@@ -4486,6 +4535,16 @@ WebGLShaderPrecisionFormat* WebGLRenderingContextBase::getShaderPrecisionFormat(
       return nullptr;
   }
 
+  // [WebGL 指纹防御] GPU profile 中的精度直接本地返回
+  if (const auto* profile_precision =
+          FingerprintConfig::Instance().GetWebGLShaderPrecision(
+              shader_type, precision_type)) {
+    FINGERPRINT_TRACE_HOOK("WebGLGetShaderPrecisionFormat", true);
+    return MakeGarbageCollected<WebGLShaderPrecisionFormat>(
+        profile_precision->range_min, profile_precision->range_max,
+        profile_precision->precision);
+  }
+
   GLint range[2] = {0, 0};
   GLint precision = 0;
   ContextGL()->GetShaderPrecisionFormat(shader_type, precision_type, range,
@@ -4514,6 +4573,20 @@ WebGLRenderingContextBase::getSupportedExtensions() {
       result.push_back(tracker->ExtensionName());
     }
   }
+  // [WebGL 指纹防御] GPU profile 给出扩展列表时按 profile 的顺序返回，
+  // 不再打乱或注入伪造扩展。
+  if (const Vector<String>* profile_extensions =
+          FingerprintConfig::Instance().GetWebGLExtensions()) {
+    FINGERPRINT_TRACE_HOOK("WebGLGetSupportedExtensions", true);
+    Vector<String> ordered;
+    ordered.reserve(result.size());
+    for (const String& name : *profile_extensions) {
+      if (result.Contains(name)) {
+        ordered.push_back(name);
+      }
+    }
+    return ordered;
+  }
   // >>>>>>>>> 修改 A：扩展列表随机化
   unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
   std::default_random_engine engine(seed);
@@ -5295,6 +5368,198 @@ bool WebGLRenderingContextBase::ValidateReadPixelsFuncParameters(
   return true;
 }
 
+namespace {
+
+// Layout of one readPixels() pixel for the noise below.
+struct ReadPixelsNoiseLayout {
+  // Bytes per pixel.
+  size_t pixel_size = 0;
+  // Byte offset of each noised colour channel's least significant bit and
+  // its position within that byte, little-endian. Alpha is never noised.
+  std::array<uint8_t, 3> lsb_byte = {};
+  std::array<uint8_t, 3> lsb_bit = {};
+  size_t channels = 0;
+  // Byte range of the alpha channel, for formats that have one: pixels whose
+  // alpha bits are all zero are left alone so that blank areas stay blank.
+  size_t alpha_offset = 0;
+  size_t alpha_size = 0;
+  uint32_t alpha_mask = 0;
+};
+
+std::optional<ReadPixelsNoiseLayout> GetReadPixelsNoiseLayout(GLenum format,
+                                                              GLenum type) {
+  ReadPixelsNoiseLayout layout;
+  // Packed types: one 16- or 32-bit word per pixel.
+  auto packed = [&layout](size_t size, std::array<uint8_t, 3> lsb,
+                          uint32_t alpha_mask) {
+    layout.pixel_size = size;
+    layout.channels = 3;
+    for (size_t i = 0; i < 3; ++i) {
+      layout.lsb_byte[i] = lsb[i] / 8;
+      layout.lsb_bit[i] = lsb[i] % 8;
+    }
+    layout.alpha_offset = 0;
+    layout.alpha_size = alpha_mask ? size : 0;
+    layout.alpha_mask = alpha_mask;
+    return layout;
+  };
+  switch (type) {
+    case GL_UNSIGNED_SHORT_5_6_5:
+      return packed(2, {11, 5, 0}, 0);
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+      return packed(2, {12, 8, 4}, 0x000Fu);
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+      return packed(2, {11, 6, 1}, 0x0001u);
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+      return packed(4, {0, 10, 20}, 0xC0000000u);
+    default:
+      break;
+  }
+
+  size_t component_size = 0;
+  switch (type) {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+      component_size = 1;
+      break;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+    case GL_HALF_FLOAT_OES:
+      component_size = 2;
+      break;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+      component_size = 4;
+      break;
+    default:
+      return std::nullopt;
+  }
+  size_t components = 0;
+  bool has_alpha = false;
+  switch (format) {
+    case GL_RGBA:
+    case GL_RGBA_INTEGER:
+      components = 4;
+      has_alpha = true;
+      break;
+    case GL_RGB:
+    case GL_RGB_INTEGER:
+      components = 3;
+      break;
+    case GL_RG:
+    case GL_RG_INTEGER:
+      components = 2;
+      break;
+    case GL_RED:
+    case GL_RED_INTEGER:
+      components = 1;
+      break;
+    default:
+      // GL_ALPHA has no colour channel to noise.
+      return std::nullopt;
+  }
+  // Integer, half-float and float components alike keep their least
+  // significant bit in bit 0 of their first byte.
+  layout.pixel_size = components * component_size;
+  layout.channels = std::min<size_t>(components, 3);
+  for (size_t i = 0; i < layout.channels; ++i) {
+    layout.lsb_byte[i] = static_cast<uint8_t>(i * component_size);
+  }
+  if (has_alpha) {
+    layout.alpha_offset = 3 * component_size;
+    layout.alpha_size = component_size;
+    layout.alpha_mask = 0xFFFFFFFFu;
+  }
+  return layout;
+}
+
+// Replaces the colour channels' least significant bits of the pixels of
+// |noised_rect| (framebuffer coordinates) in the result of
+// ReadPixels(x, y, width, height, format, type) with |tile|'s bits for
+// their framebuffer coordinates. |pixels| starts where ReadPixels() was
+// told to write and is laid out by |params|.
+void ApplyReadPixelsNoise(const FingerprintNoiseTile& tile,
+                          GLint x,
+                          GLint y,
+                          GLsizei width,
+                          GLsizei height,
+                          const gfx::Rect& noised_rect,
+                          GLenum format,
+                          GLenum type,
+                          const WebGLImageConversion::PixelStoreParams& params,
+                          base::span<uint8_t> pixels) {
+  if (noised_rect.IsEmpty() || width <= 0 || height <= 0) {
+    return;
+  }
+  const std::optional<ReadPixelsNoiseLayout> layout =
+      GetReadPixelsNoiseLayout(format, type);
+  if (!layout) {
+    return;
+  }
+  const size_t row_pixels =
+      params.row_length > 0 ? static_cast<size_t>(params.row_length)
+                            : static_cast<size_t>(width);
+  const size_t alignment = std::max(params.alignment, 1);
+  const size_t row_bytes =
+      (row_pixels * layout->pixel_size + alignment - 1) / alignment *
+      alignment;
+  const size_t first_row = static_cast<size_t>(noised_rect.y() - y) +
+                           static_cast<size_t>(std::max(params.skip_rows, 0));
+  const size_t first_column =
+      static_cast<size_t>(noised_rect.x() - x) +
+      static_cast<size_t>(std::max(params.skip_pixels, 0));
+  const size_t noised_row_size =
+      static_cast<size_t>(noised_rect.width()) * layout->pixel_size;
+  const size_t noised_size =
+      row_bytes * static_cast<size_t>(noised_rect.height() - 1) +
+      noised_row_size;
+  const size_t start = first_row * row_bytes + first_column * layout->pixel_size;
+  if (start > pixels.size() || pixels.size() - start < noised_size) {
+    return;
+  }
+  pixels = pixels.subspan(start, noised_size);
+
+  // The common case takes the canvas kernel, which streams whole rows.
+  if (format == GL_RGBA && type == GL_UNSIGNED_BYTE) {
+    tile.ApplyToPixels(pixels, row_bytes, noised_rect.width(),
+                       noised_rect.height(), noised_rect.x(), noised_rect.y());
+    return;
+  }
+
+  for (int row = 0; row < noised_rect.height(); ++row) {
+    base::span<uint8_t> row_pixels_span = pixels.subspan(
+        static_cast<size_t>(row) * row_bytes, noised_row_size);
+    const int pixel_y = noised_rect.y() + row;
+    for (int column = 0; column < noised_rect.width(); ++column) {
+      base::span<uint8_t> pixel = row_pixels_span.subspan(
+          static_cast<size_t>(column) * layout->pixel_size,
+          layout->pixel_size);
+      if (layout->alpha_size) {
+        uint32_t alpha = 0;
+        // SAFETY: alpha_size <= 4 bytes within the pixel.
+        UNSAFE_BUFFERS(memcpy(&alpha, pixel.data() + layout->alpha_offset,
+                              layout->alpha_size));
+        if (!(alpha & layout->alpha_mask)) {
+          continue;
+        }
+      }
+      const uint8_t bits = tile.At(noised_rect.x() + column, pixel_y);
+      for (size_t channel = 0; channel < layout->channels; ++channel) {
+        uint8_t& byte = pixel[layout->lsb_byte[channel]];
+        const uint8_t mask =
+            static_cast<uint8_t>(1u << layout->lsb_bit[channel]);
+        byte = static_cast<uint8_t>(
+            (byte & ~mask) |
+            (((bits >> channel) & 1u) << layout->lsb_bit[channel]));
+      }
+    }
+  }
+}
+
+}  // namespace
+
 void WebGLRenderingContextBase::readPixels(
     GLint x,
     GLint y,
@@ -5307,38 +5572,10 @@ void WebGLRenderingContextBase::readPixels(
     return;
   }
 
-  // 1. 原始读取调用
+  // 噪声在 ReadPixelsHelper 中施加，WebGL2 的 ArrayBufferView 重载同样经过那里。
+  // 读入 PIXEL_PACK_BUFFER 的 WebGL2 重载 (随后 getBufferSubData) 不经过这里，
+  // 不加噪。
   ReadPixelsHelper(x, y, width, height, format, type, pixels.Get(), 0);
-
-  // >>>>>>>>> 修改 D：读取时强力干扰
-  if (!isContextLost() && pixels && pixels->byteLength() > 0) {
-    void* data_ptr = pixels->BaseAddress();
-    if (data_ptr) {
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
-
-      unsigned char* data = static_cast<unsigned char*>(data_ptr);
-      size_t len = pixels->byteLength();
-
-      int max_noise =
-          blink::FingerprintConfig::Instance().GetWebGLReadPixelsNoiseMax();
-      int pixel_noise = (GetDeterministicNoiseInt(30000) % max_noise) + 1;
-
-      // 修改开头 10 字节
-      for (size_t i = 0; i < len && i < 10; i++) {
-        data[i] = static_cast<unsigned char>(data[i] + pixel_noise);
-      }
-
-      // 修改中间 10 字节
-      size_t mid = len / 2;
-      for (size_t i = mid; i < len && i < mid + 10; i++) {
-        data[i] = static_cast<unsigned char>(data[i] + pixel_noise);
-      }
-
-#pragma clang diagnostic pop
-    }
-  }
-  // <<<<<<<<< 修改 D 结束
 }
 
 void WebGLRenderingContextBase::ReadPixelsHelper(GLint x,
@@ -5418,6 +5655,41 @@ void WebGLRenderingContextBase::ReadPixelsHelper(GLint x,
     }
     ContextGL()->ReadPixels(x, y, width, height, format, type, data);
   }
+
+  // >>>>>>>>> [WebGL 指纹防御] readPixels 噪声
+  // 按 (seed, 帧缓冲绝对坐标, 通道) 确定：同一像素无论读取区域、读取次数及
+  // 其间的 viewport()/clearColor() 调用如何，结果都相同。
+  const bool spoofed =
+      FingerprintConfig::Instance().GetWebGLReadPixelsNoiseMax() > 0;
+  FINGERPRINT_TRACE_HOOK("WebGLReadPixels", spoofed);
+  if (spoofed && !buffer) {
+    // ReadPixels() leaves pixels outside the read buffer as the page passed
+    // them in, so only the part it wrote is noised.
+    gfx::Rect noised_rect(x, y, width, height);
+    if (!framebuffer) {
+      noised_rect.Intersect(gfx::Rect(GetDrawingBuffer()->Size()));
+    } else if (WebGLObject* attachment = framebuffer->GetAttachmentObject(
+                   framebuffer->GetReadBuffer());
+               attachment && attachment->IsRenderbuffer()) {
+      const auto* renderbuffer = static_cast<WebGLRenderbuffer*>(attachment);
+      noised_rect.Intersect(
+          gfx::Rect(renderbuffer->Width(), renderbuffer->Height()));
+    } else {
+      // Blink does not track texture sizes; a texture attachment is only
+      // known not to extend below the origin.
+      noised_rect.Intersect(gfx::Rect(0, 0, std::numeric_limits<int>::max(),
+                                      std::numeric_limits<int>::max()));
+    }
+    ApplyReadPixelsNoise(
+        *FingerprintNoiseTile::Get(FingerprintConfig::Instance().GetGlobalSeed(),
+                                   FingerprintNoiseDomain::kWebGL),
+        x, y, width, height, noised_rect, format, type,
+        GetPackPixelStoreParams(),
+        // SAFETY: the validation above checked that |buffer_size| bytes are
+        // available from |data|.
+        UNSAFE_BUFFERS(base::span(data, buffer_size.ValueOrDie())));
+  }
+  // <<<<<<<<< [WebGL 指纹防御]
 }
 
 void WebGLRenderingContextBase::RenderbufferStorageImpl(
@@ -7734,16 +8006,20 @@ void WebGLRenderingContextBase::viewport(GLint x,
   if (isContextLost()) {
     return;
   }
-  // >>>>>>>>> 修改 E：Viewport 随机微调 (解决 Hash 不变的核心)
-  int max_noise =
-      blink::FingerprintConfig::Instance().GetWebGLViewportNoiseMax();
-  int noise = GetDeterministicNoiseInt(30000) % (max_noise + 1);
+  // render_exact：原样下发，噪声只在读回出口施加。
+  if (!fingerprint_render_exact_) {
+    // >>>>>>>>> 修改 E：Viewport 随机微调 (解决 Hash 不变的核心)
+    int max_noise =
+        blink::FingerprintConfig::Instance().GetWebGLViewportNoiseMax();
+    FINGERPRINT_TRACE_HOOK("WebGLViewport", max_noise > 0);
+    int noise = GetDeterministicNoiseInt(30000) % (max_noise + 1);
 
-  if (noise > 0 && width > max_noise && height > max_noise) {
-    width = width - noise;
-    height = height - noise;
+    if (noise > 0 && width > max_noise && height > max_noise) {
+      width = width - noise;
+      height = height - noise;
+    }
+    // <<<<<<<<< 修改 E 结束
   }
-  // <<<<<<<<< 修改 E 结束
   ContextGL()->Viewport(x, y, width, height);
 }
 
@@ -8071,7 +8347,13 @@ ScriptValue WebGLRenderingContextBase::GetFloatParameter(
     GLenum pname) {
   GLfloat value = 0;
   if (!isContextLost()) {
-    ContextGL()->GetFloatv(pname, &value);
+    // [WebGL 指纹防御] GPU profile 给出的静态上限本地作答，不经 GPU 进程
+    if (const auto* parameter =
+            FingerprintConfig::Instance().GetWebGLParameter(pname)) {
+      value = static_cast<GLfloat>(parameter->values[0]);
+    } else {
+      ContextGL()->GetFloatv(pname, &value);
+    }
   }
   return WebGLAny(script_state, value);
 }
@@ -8081,6 +8363,10 @@ ScriptValue WebGLRenderingContextBase::GetIntParameter(
     GLenum pname) {
   GLint value = 0;
   if (!isContextLost()) {
+    if (const auto* parameter =
+            FingerprintConfig::Instance().GetWebGLParameter(pname)) {
+      return WebGLAny(script_state, static_cast<GLint>(parameter->values[0]));
+    }
     ContextGL()->GetIntegerv(pname, &value);
     switch (pname) {
       case GL_IMPLEMENTATION_COLOR_READ_FORMAT:
@@ -8113,7 +8399,12 @@ ScriptValue WebGLRenderingContextBase::GetUnsignedIntParameter(
     GLenum pname) {
   GLint value = 0;
   if (!isContextLost()) {
-    ContextGL()->GetIntegerv(pname, &value);
+    if (const auto* parameter =
+            FingerprintConfig::Instance().GetWebGLParameter(pname)) {
+      value = static_cast<GLint>(parameter->values[0]);
+    } else {
+      ContextGL()->GetIntegerv(pname, &value);
+    }
   }
   return WebGLAny(script_state, static_cast<unsigned>(value));
 }
@@ -8123,7 +8414,14 @@ ScriptValue WebGLRenderingContextBase::GetWebGLFloatArrayParameter(
     GLenum pname) {
   std::array<GLfloat, 4> value = {0};
   if (!isContextLost()) {
-    ContextGL()->GetFloatv(pname, value.data());
+    if (const auto* parameter =
+            FingerprintConfig::Instance().GetWebGLParameter(pname)) {
+      for (wtf_size_t i = 0; i < parameter->count; ++i) {
+        value[i] = static_cast<GLfloat>(parameter->values[i]);
+      }
+    } else {
+      ContextGL()->GetFloatv(pname, value.data());
+    }
   }
   unsigned length = 0;
   switch (pname) {
@@ -8148,7 +8446,14 @@ ScriptValue WebGLRenderingContextBase::GetWebGLIntArrayParameter(
     GLenum pname) {
   std::array<GLint, 4> value = {0};
   if (!isContextLost()) {
-    ContextGL()->GetIntegerv(pname, value.data());
+    if (const auto* parameter =
+            FingerprintConfig::Instance().GetWebGLParameter(pname)) {
+      for (wtf_size_t i = 0; i < parameter->count; ++i) {
+        value[i] = static_cast<GLint>(parameter->values[i]);
+      }
+    } else {
+      ContextGL()->GetIntegerv(pname, value.data());
+    }
   }
   unsigned length = 0;
   switch (pname) {
@@ -9640,10 +9945,12 @@ bool WebGLRenderingContextBase::checkProgramCompletionQueryAvailable(
 
 int WebGLRenderingContextBase::GetDeterministicNoiseInt(int max) {
   // Use instance counter for per-context determinism (resets on page reload)
-  double noise = blink::FingerprintConfig::GenerateNoise(
-      static_cast<double>(fingerprint_noise_counter_++),
-      static_cast<double>(max));
-  return static_cast<int>(std::abs(noise));
+  if (max <= 0) {
+    return 0;
+  }
+  return static_cast<int>(
+      FingerprintNoise(FingerprintNoiseDomain::kWebGL)
+          .Below(fingerprint_noise_counter_++, static_cast<uint32_t>(max)));
 }
 
 }  // namespace blink
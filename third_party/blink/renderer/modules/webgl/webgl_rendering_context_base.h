@@ -2115,6 +2115,9 @@ class MODULES_EXPORT WebGLRenderingContextBase
 
   // [Fingerprint] Per-context deterministic noise counter
   int fingerprint_noise_counter_ = 0;
+  // [Fingerprint] Render-exact mode, read once per context so that
+  // viewport() and clearColor() cost no config lookup per call.
+  bool fingerprint_render_exact_ = false;
   int GetDeterministicNoiseInt(int max);
 
   // Support for KHR_parallel_shader_compile.
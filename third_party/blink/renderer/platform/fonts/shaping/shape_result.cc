@@ -11,10 +11,11 @@
 #include "base/containers/adapters.h"
 #include "base/memory/ptr_util.h"
 #include "base/numerics/safe_conversions.h"
-#include "base/rand_util.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 #include "third_party/blink/renderer/core/frame/fingerprint_config.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_noise.h"
+#include "third_party/blink/renderer/core/frame/fingerprint_trace.h"
 #include "third_party/blink/renderer/platform/fonts/character_range.h"
 #include "third_party/blink/renderer/platform/fonts/font.h"
 #include "third_party/blink/renderer/platform/fonts/shaping/glyph_bounds_accumulator.h"
@@ -2528,22 +2529,27 @@ float ShapeResult::Width() const {
   float w = width_;
 
   // ȡָõ
-  FingerprintConfig* config = FingerprintConfig::GetInstance();
+  const FingerprintConfig* config = FingerprintConfig::GetInstance();
 
   // 1. Ƿ (fingerprint.json е
   // fonts.offset_noise_prob_percent) ĬֵΪ 0 ԷֹδʼʱΪ
   int prob = config->GetFontsOffsetNoiseProbPercent();
+  FINGERPRINT_TRACE_HOOK("ShapeResultWidth", prob > 0);
 
-  //  1  100 ֮
-  int random_threshold = base::RandInt(1, 100);
+  if (prob <= 0) {
+    return w;
+  }
 
-  // Сڵõĸʣʩ
-  if (random_threshold <= prob) {
-    // 2.ʹ˫ (Bipolar Noise)
-    // base::RandDouble()  [0, 1)
-    // (Rand - 0.5) * 0.1  [-0.05, +0.05) ķΧ
+  //  (, , ַ) Ϊȷͬһÿβͬ
+  // Ҳ·ϵ CSPRNG
+  const FingerprintNoise noise_source(FingerprintNoiseDomain::kFonts);
+  const uint64_t counter =
+      FingerprintNoise::CounterFromDouble(w) * 0x100000001B3ull ^
+      num_characters_;
+  if (noise_source.Chance(counter, prob)) {
+    // 2.ʹ˫ (Bipolar Noise)Χ [-0.05, +0.05)
     // ȷȼȿӣҲܼ٣ӶԵĲȷ
-    double noise = (base::RandDouble() - 0.5) * 0.1;
+    const double noise = noise_source.Signed(counter + 1) * 0.05;
 
     return w + static_cast<float>(noise);
   }
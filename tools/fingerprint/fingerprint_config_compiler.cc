@@ -0,0 +1,239 @@
+// Copyright 2025 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compiles fingerprint identity JSON files into checksummed binary images.
+//
+// Usage:
+//   fingerprint_config_compiler [--check] [--output-dir=DIR]
+//       [--gpu-profile-library=gpu_profiles.fpgl] FILE.json...
+//   fingerprint_config_compiler [--check] --gpu-profiles=gpu_profiles.fpgl
+//       PROFILES.json...
+//
+// Every input is validated strictly (unknown keys, wrong types and
+// out-of-range values are errors) and written as DIR/<name>.fpci, next to the
+// input by default. Identities that select a GPU profile are resolved against
+// --gpu-profile-library, and an unknown profile is an error.
+//
+// With --gpu-profiles the inputs are captured GPU profiles instead, each file
+// holding one profile object or a list of them, and are compiled together
+// into one library.
+//
+// With --check nothing is written. Exits non-zero if any input failed, after
+// reporting all of them.
+
+#include <stdio.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/check.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_config_image.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_gpu_profile_library.h"
+#include "third_party/blink/public/common/fingerprint/fingerprint_identity.h"
+
+namespace {
+
+constexpr char kCheckSwitch[] = "check";
+constexpr char kOutputDirSwitch[] = "output-dir";
+constexpr char kGpuProfilesSwitch[] = "gpu-profiles";
+constexpr char kGpuProfileLibrarySwitch[] = "gpu-profile-library";
+
+void PrintError(const base::FilePath& input, const std::string& message) {
+  fprintf(stderr, "%s: %s\n", input.AsUTF8Unsafe().c_str(), message.c_str());
+}
+
+std::optional<base::Value> ReadJson(const base::FilePath& input) {
+  std::string json;
+  if (!base::ReadFileToString(input, &json)) {
+    PrintError(input, "could not read file");
+    return std::nullopt;
+  }
+  auto parsed = base::JSONReader::ReadAndReturnValueWithError(
+      json, base::JSON_PARSE_CHROMIUM_EXTENSIONS);
+  if (!parsed.has_value()) {
+    PrintError(input, parsed.error().message);
+    return std::nullopt;
+  }
+  return std::move(*parsed);
+}
+
+bool WriteOutput(const base::FilePath& output,
+                 const std::vector<uint8_t>& bytes) {
+  // Written atomically: the browser may be watching the output directory.
+  if (!base::ImportantFileWriter::WriteFileAtomically(
+          output, std::string(bytes.begin(), bytes.end()))) {
+    PrintError(output, "could not write file");
+    return false;
+  }
+  return true;
+}
+
+// Returns true if |input| compiled cleanly (and, unless |check_only|, was
+// written to |output_dir|).
+bool CompileIdentity(const base::FilePath& input,
+                     const base::FilePath& output_dir,
+                     const blink::FingerprintGpuProfileLibrary* gpu_profiles,
+                     bool check_only) {
+  std::optional<base::Value> parsed = ReadJson(input);
+  if (!parsed) {
+    return false;
+  }
+  if (!parsed->is_dict()) {
+    PrintError(input, "top level is not an object");
+    return false;
+  }
+
+  std::vector<std::string> errors;
+  bool valid =
+      blink::FingerprintConfigImage::Validate(parsed->GetDict(), &errors);
+  if (const std::string* profile =
+          parsed->GetDict().FindStringByDottedPath("webgl.profile");
+      profile && (!gpu_profiles || !gpu_profiles->Find(*profile))) {
+    errors.push_back("webgl.profile: unknown GPU profile " + *profile);
+    valid = false;
+  }
+  if (!valid) {
+    for (const std::string& error : errors) {
+      PrintError(input, error);
+    }
+    return false;
+  }
+
+  std::vector<uint8_t> image_bytes =
+      blink::FingerprintConfigImage::Compile(parsed->GetDict(), gpu_profiles);
+  CHECK(blink::FingerprintConfigImage::FromBytesVerified(image_bytes));
+  if (check_only) {
+    return true;
+  }
+
+  base::FilePath output =
+      (output_dir.empty() ? input.DirName() : output_dir)
+          .Append(input.BaseName().RemoveExtension())
+          .AddExtension(blink::kFingerprintImageExtension);
+  return WriteOutput(output, image_bytes);
+}
+
+// Returns true if every profile in |inputs| compiled cleanly into one library
+// (and, unless |check_only|, it was written to |output|).
+bool CompileGpuProfiles(const base::CommandLine::StringVector& inputs,
+                        const base::FilePath& output,
+                        bool check_only) {
+  bool valid = true;
+  std::vector<base::Value::Dict> profiles;
+  for (const auto& input_name : inputs) {
+    const base::FilePath input(input_name);
+    std::optional<base::Value> parsed = ReadJson(input);
+    if (!parsed) {
+      valid = false;
+    } else if (parsed->is_dict()) {
+      profiles.push_back(std::move(parsed->GetDict()));
+    } else if (parsed->is_list()) {
+      for (base::Value& profile : parsed->GetList()) {
+        if (!profile.is_dict()) {
+          PrintError(input, "list item is not an object");
+          valid = false;
+          break;
+        }
+        profiles.push_back(std::move(profile.GetDict()));
+      }
+    } else {
+      PrintError(input, "top level is not an object or a list");
+      valid = false;
+    }
+  }
+
+  std::vector<std::string> errors;
+  std::vector<uint8_t> library_bytes =
+      blink::FingerprintGpuProfileLibrary::Compile(profiles, &errors);
+  for (const std::string& error : errors) {
+    PrintError(output, error);
+  }
+  if (!valid || !errors.empty()) {
+    return false;
+  }
+  CHECK(blink::FingerprintGpuProfileLibrary::FromBytesVerified(library_bytes));
+  return check_only || WriteOutput(output, library_bytes);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit_manager;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  const base::CommandLine::StringVector inputs = command_line.GetArgs();
+  if (inputs.empty()) {
+    const std::string program =
+        command_line.GetProgram().BaseName().AsUTF8Unsafe();
+    fprintf(stderr,
+            "Usage: %s [--check] [--output-dir=DIR] "
+            "[--gpu-profile-library=FILE] FILE.json...\n"
+            "       %s [--check] --gpu-profiles=OUT.fpgl PROFILES.json...\n",
+            program.c_str(), program.c_str());
+    return 2;
+  }
+
+  const bool check_only = command_line.HasSwitch(kCheckSwitch);
+  if (command_line.HasSwitch(kGpuProfilesSwitch)) {
+    const base::FilePath output =
+        command_line.GetSwitchValuePath(kGpuProfilesSwitch);
+    if (output.empty()) {
+      fprintf(stderr, "--gpu-profiles needs an output file\n");
+      return 2;
+    }
+    if (!CompileGpuProfiles(inputs, output, check_only)) {
+      fprintf(stderr, "GPU profile library failed\n");
+      return 1;
+    }
+    return 0;
+  }
+
+  base::MemoryMappedFile gpu_profile_file;
+  const blink::FingerprintGpuProfileLibrary* gpu_profiles = nullptr;
+  const base::FilePath gpu_profile_path =
+      command_line.GetSwitchValuePath(kGpuProfileLibrarySwitch);
+  if (!gpu_profile_path.empty()) {
+    if (gpu_profile_file.Initialize(gpu_profile_path)) {
+      gpu_profiles = blink::FingerprintGpuProfileLibrary::FromBytesVerified(
+          gpu_profile_file.bytes());
+    }
+    if (!gpu_profiles) {
+      PrintError(gpu_profile_path, "not a valid GPU profile library");
+      return 1;
+    }
+  }
+
+  const base::FilePath output_dir =
+      command_line.GetSwitchValuePath(kOutputDirSwitch);
+  if (!output_dir.empty() && !check_only &&
+      !base::CreateDirectory(output_dir)) {
+    PrintError(output_dir, "could not create directory");
+    return 1;
+  }
+
+  size_t failures = 0;
+  for (const auto& input : inputs) {
+    if (!CompileIdentity(base::FilePath(input), output_dir, gpu_profiles,
+                         check_only)) {
+      ++failures;
+    }
+  }
+  if (failures) {
+    fprintf(stderr, "%zu of %zu identities failed\n", failures, inputs.size());
+    return 1;
+  }
+  return 0;
+}